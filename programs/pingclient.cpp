@@ -6,22 +6,40 @@
 
 ndnph::Face& face = ndnph::cli::openUplink();
 
-std::unique_ptr<ndnph::PingClient> client;
+using Client = ndnph::BasicConcurrentPingClient<1024>;
+std::unique_ptr<Client> client;
+int reportInterval = 1000;
 
 static bool
 parseArgs(int argc, char** argv) {
-  int interval = 1000;
+  Client::Options opts;
 
   int c;
-  while ((c = getopt(argc, argv, "i:")) != -1) {
+  while ((c = getopt(argc, argv, "i:t:r:")) != -1) {
     switch (c) {
       case 'i': {
-        interval = atoi(optarg);
-        if (interval <= 0 || interval > 60000) {
+        opts.interval = atoi(optarg);
+        if (opts.interval <= 0 || opts.interval > 60000) {
           return false;
         }
         break;
       }
+      case 't': {
+        opts.timeout = atoi(optarg);
+        if (opts.timeout <= 0 || opts.timeout > 60000) {
+          return false;
+        }
+        break;
+      }
+      case 'r': {
+        reportInterval = atoi(optarg);
+        if (reportInterval <= 0) {
+          return false;
+        }
+        break;
+      }
+      default:
+        return false;
     }
   }
 
@@ -31,29 +49,43 @@ parseArgs(int argc, char** argv) {
   const char* prefix = argv[optind];
 
   static ndnph::StaticRegion<1024> prefixRegion;
-  client.reset(new ndnph::PingClient(ndnph::Name::parse(prefixRegion, prefix), face, interval));
+  client.reset(new Client(ndnph::Name::parse(prefixRegion, prefix), face, opts));
   return true;
 }
 
+static void
+printStats() {
+  auto cnt = client->readCounters();
+  const auto& rtt = client->getRtt();
+  printf("%" PRIu32 "I %" PRIu32 "D %" PRIu32 "T %0.2f%% rtt(us) min/avg/p50/p99/max "
+         "%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "\n",
+         cnt.nTxInterests, cnt.nRxData, cnt.nTimeouts,
+         cnt.nTxInterests == 0 ? 0.0 : 100.0 * cnt.nRxData / cnt.nTxInterests, rtt.min(),
+         rtt.mean(), rtt.quantile(0.50), rtt.quantile(0.99), rtt.max());
+}
+
 int
 main(int argc, char** argv) {
   if (!parseArgs(argc, argv)) {
-    fprintf(stderr, "ndnph-pingclient [-i INTERVAL] PREFIX\n"
-                    "  PREFIX should have 'ping' suffix to interact with ndn-tools ndnpingserver.\n"
-                    "  INTERVAL must be between 1 and 60000 milliseconds.\n"
-                    "  INTERVAL should be no less than RTT, or all requests will timeout.\n");
+    fprintf(stderr,
+            "ndnph-pingclient [-i INTERVAL] [-t TIMEOUT] [-r REPORT] PREFIX\n"
+            "  PREFIX should have 'ping' suffix to interact with ndn-tools ndnpingserver.\n"
+            "  INTERVAL must be between 1 and 60000 milliseconds.\n"
+            "  TIMEOUT must be between 1 and 60000 milliseconds, default is 1000.\n"
+            "  REPORT is statistics reporting interval in milliseconds, default is 1000.\n"
+            "  Up to 1024 probes can be outstanding, so INTERVAL may be shorter than RTT.\n");
     return 1;
   }
 
+  auto nextReport = ndnph::port::Clock::add(ndnph::port::Clock::now(), reportInterval);
   for (;;) {
     ndnph::port::Clock::sleep(1);
     face.loop();
 
-    static uint16_t i = 0;
-    if (++i % 1024 == 0) {
-      auto cnt = client->readCounters();
-      printf("%" PRIu32 "I %" PRIu32 "D %0.2f%%\n", cnt.nTxInterests, cnt.nRxData,
-             100.0 * cnt.nRxData / cnt.nTxInterests);
+    auto now = ndnph::port::Clock::now();
+    if (!ndnph::port::Clock::isBefore(now, nextReport)) {
+      printStats();
+      nextReport = ndnph::port::Clock::add(now, reportInterval);
     }
   }
 }
@@ -0,0 +1,75 @@
+#define NDNPH_WANT_CLI
+#define NDNPH_MEMIF_DEBUG
+#define NDNPH_SOCKET_DEBUG
+#include <NDNph-config.h>
+#include <NDNph.h>
+
+ndnph::Face& face = ndnph::cli::openUplink();
+
+using Server = ndnph::BasicFastPingServer<9200>;
+std::unique_ptr<Server> server;
+std::unique_ptr<uint8_t[]> payload;
+
+static bool
+parseArgs(int argc, char** argv) {
+  int payloadLen = 0;
+  int freshness = 1;
+
+  int c;
+  while ((c = getopt(argc, argv, "s:f:")) != -1) {
+    switch (c) {
+      case 's': {
+        payloadLen = atoi(optarg);
+        if (payloadLen < 0 || payloadLen > 8800) {
+          return false;
+        }
+        break;
+      }
+      case 'f': {
+        freshness = atoi(optarg);
+        if (freshness < 0) {
+          return false;
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  if (argc - optind != 1) {
+    return false;
+  }
+  const char* prefix = argv[optind];
+
+  payload.reset(new uint8_t[payloadLen]());
+  static ndnph::StaticRegion<1024> prefixRegion;
+  server.reset(new Server(ndnph::Name::parse(prefixRegion, prefix), face,
+                          ndnph::tlv::Value(payload.get(), payloadLen), freshness));
+  return true;
+}
+
+int
+main(int argc, char** argv) {
+  if (!parseArgs(argc, argv)) {
+    fprintf(stderr, "ndnph-pingserver [-s SIZE] [-f FRESHNESS] PREFIX\n"
+                    "  PREFIX should have 'ping' suffix to interact with ndn-tools ndnping.\n"
+                    "  SIZE is Data payload length, between 0 and 8800 octets.\n"
+                    "  FRESHNESS is Data FreshnessPeriod in milliseconds, default is 1.\n");
+    return 1;
+  }
+
+  auto nextReport = ndnph::port::Clock::add(ndnph::port::Clock::now(), 1000);
+  uint32_t lastCnt = 0;
+  for (;;) {
+    face.loop();
+
+    auto now = ndnph::port::Clock::now();
+    if (!ndnph::port::Clock::isBefore(now, nextReport)) {
+      auto cnt = server->readCounters();
+      printf("%" PRIu32 "D %" PRIu32 "D/s\n", cnt.nTxData, cnt.nTxData - lastCnt);
+      lastCnt = cnt.nTxData;
+      nextReport = ndnph::port::Clock::add(now, 1000);
+    }
+  }
+}
@@ -8,6 +8,7 @@
 #include "ndnph/port/sha256/port.hpp"
 #include "ndnph/port/timingsafe/port.hpp"
 #include "ndnph/port/unixtime/port.hpp"
+#include "ndnph/app/congestion-window.hpp"
 #include "ndnph/app/ndncert/an.hpp"
 #include "ndnph/app/ndncert/client.hpp"
 #include "ndnph/app/ndncert/common.hpp"
@@ -16,8 +17,10 @@
 #include "ndnph/app/ping-server.hpp"
 #include "ndnph/app/rdr.hpp"
 #include "ndnph/app/segment-consumer.hpp"
+#include "ndnph/app/segment-manifest.hpp"
 #include "ndnph/app/segment-producer.hpp"
 #include "ndnph/core/common.hpp"
+#include "ndnph/core/hash.hpp"
 #include "ndnph/core/input-iterator-pointer-proxy.hpp"
 #include "ndnph/core/log.hpp"
 #include "ndnph/core/operators.hpp"
@@ -26,11 +29,13 @@
 #include "ndnph/core/simple-queue.hpp"
 #include "ndnph/face/bridge-transport.hpp"
 #include "ndnph/face/face.hpp"
+#include "ndnph/face/lp-reliability.hpp"
 #include "ndnph/face/packet-handler.hpp"
 #include "ndnph/face/transport-force-endpointid.hpp"
 #include "ndnph/face/transport-rxqueue.hpp"
 #include "ndnph/face/transport-tracer.hpp"
 #include "ndnph/face/transport.hpp"
+#include "ndnph/fw/forwarder.hpp"
 #include "ndnph/keychain/certificate.hpp"
 #include "ndnph/keychain/digest.hpp"
 #include "ndnph/keychain/ec.hpp"
@@ -52,8 +57,12 @@
 #include "ndnph/packet/nack.hpp"
 #include "ndnph/packet/name.hpp"
 #include "ndnph/packet/sig-info.hpp"
+#include "ndnph/packet/template.hpp"
+#include "ndnph/store/async-kv.hpp"
+#include "ndnph/store/content-store.hpp"
 #include "ndnph/store/kv.hpp"
 #include "ndnph/store/packet.hpp"
+#include "ndnph/store/repo.hpp"
 #include "ndnph/tlv/decoder.hpp"
 #include "ndnph/tlv/encoder.hpp"
 #include "ndnph/tlv/ev-decoder.hpp"
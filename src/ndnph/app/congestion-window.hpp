@@ -0,0 +1,90 @@
+#ifndef NDNPH_APP_CONGESTION_WINDOW_HPP
+#define NDNPH_APP_CONGESTION_WINDOW_HPP
+
+#include "../core/common.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief AIMD congestion window for consumers.
+ *
+ * The window grows by one packet per Data during slow start, and by about one packet per window
+ * in congestion avoidance. A congestion signal, either a loss or a CongestionMark, halves the
+ * window. Signals caused by packets sent before the last decrease are ignored, so that the
+ * window is reduced at most once per round trip.
+ */
+class CongestionWindow {
+public:
+  struct Options {
+    /** @brief Initial window in packets. */
+    int initialCwnd = 2;
+
+    /** @brief Minimum window in packets. */
+    int minCwnd = 1;
+
+    /** @brief Maximum window in packets. */
+    int maxCwnd = 64;
+
+    /** @brief Initial slow start threshold in packets. */
+    int initialSsthresh = std::numeric_limits<int>::max();
+  };
+
+  explicit CongestionWindow(Options opts)
+    : m_opts(opts)
+    , m_cwnd(opts.initialCwnd * Scale::value)
+    , m_ssthresh(opts.initialSsthresh) {}
+
+  explicit CongestionWindow()
+    : CongestionWindow(Options()) {}
+
+  /** @brief Return current window in packets. */
+  int get() const {
+    return m_cwnd / Scale::value;
+  }
+
+  /** @brief Determine whether a packet may be sent with @p nOutstanding packets outstanding. */
+  bool canSend(int nOutstanding) const {
+    return nOutstanding < get();
+  }
+
+  /** @brief Handle a Data that does not carry a congestion signal. */
+  void increase() {
+    if (get() < m_ssthresh) {
+      m_cwnd += Scale::value;
+    } else {
+      m_cwnd += Scale::value * Scale::value / m_cwnd;
+    }
+    m_cwnd = std::min(m_cwnd, m_opts.maxCwnd * Scale::value);
+  }
+
+  /**
+   * @brief Handle a congestion signal.
+   * @param seqNum sequence number of the packet that experienced congestion.
+   * @param nextSeqNum sequence number of the next packet to be sent.
+   * @return whether the window has been reduced.
+   */
+  bool decrease(uint64_t seqNum, uint64_t nextSeqNum) {
+    if (m_hasRecoveryPoint && static_cast<int64_t>(seqNum - m_recoveryPoint) < 0) {
+      return false;
+    }
+    m_hasRecoveryPoint = true;
+    m_recoveryPoint = nextSeqNum;
+    m_ssthresh = std::max(get() / 2, m_opts.minCwnd);
+    m_cwnd = m_ssthresh * Scale::value;
+    return true;
+  }
+
+private:
+  /** @brief Fixed-point scale of @c m_cwnd . */
+  using Scale = std::integral_constant<int, 1000>;
+
+  Options m_opts;
+  int m_cwnd = 0;
+  int m_ssthresh = 0;
+  uint64_t m_recoveryPoint = 0;
+  bool m_hasRecoveryPoint = false;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_APP_CONGESTION_WINDOW_HPP
@@ -3,6 +3,7 @@
 
 #include "../face/packet-handler.hpp"
 #include "../port/clock/port.hpp"
+#include "congestion-window.hpp"
 
 namespace ndnph {
 
@@ -12,6 +13,7 @@ namespace ndnph {
  * This is a simple ping client implementation that can only keep one pending Interest.
  * After sending a probe Interest, responses to previous Interests are no longer accepted.
  * Therefore, interval must be greater than RTT, otherwise this client cannot receive any Data.
+ * @sa BasicConcurrentPingClient
  */
 class PingClient : public PacketHandler {
 public:
@@ -94,6 +96,310 @@ private:
   Counters m_cnt;
 };
 
+namespace ping {
+
+/**
+ * @brief Log-linear histogram of round-trip times.
+ *
+ * Values below 8 are counted exactly. Each power-of-two range above that is divided into 8
+ * equal-width buckets, so that a quantile is within 12.5% of the true value.
+ */
+class RttHistogram {
+public:
+  /** @brief Record a sample in microseconds. */
+  void add(uint32_t value) {
+    ++m_buckets[toBucket(value)];
+    ++m_count;
+    m_sum += value;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+  }
+
+  /** @brief Clear all samples. */
+  void clear() {
+    *this = RttHistogram();
+  }
+
+  uint32_t count() const {
+    return m_count;
+  }
+
+  /** @brief Return minimum sample, or 0 if there's no sample. */
+  uint32_t min() const {
+    return m_count == 0 ? 0 : m_min;
+  }
+
+  /** @brief Return maximum sample. */
+  uint32_t max() const {
+    return m_max;
+  }
+
+  /** @brief Return arithmetic mean of samples, or 0 if there's no sample. */
+  uint32_t mean() const {
+    return m_count == 0 ? 0 : static_cast<uint32_t>(m_sum / m_count);
+  }
+
+  /**
+   * @brief Estimate a quantile.
+   * @param q quantile between 0.0 and 1.0, such as 0.99 for p99.
+   * @return upper bound of the bucket containing the quantile, clamped to [min, max].
+   */
+  uint32_t quantile(double q) const {
+    if (m_count == 0) {
+      return 0;
+    }
+    double r = q * m_count;
+    uint32_t rank = static_cast<uint32_t>(r);
+    rank = std::max<uint32_t>(1, rank + static_cast<uint32_t>(rank < r));
+    uint32_t seen = 0;
+    for (size_t i = 0; i < NBuckets; ++i) {
+      seen += m_buckets[i];
+      if (seen >= rank) {
+        return std::max(m_min, std::min(m_max, bucketUpper(i)));
+      }
+    }
+    return m_max;
+  }
+
+private:
+  static constexpr int SubBits = 3;
+  static constexpr size_t NSub = 1 << SubBits;
+  static constexpr size_t NBuckets = (32 - SubBits + 1) * NSub;
+
+  static size_t toBucket(uint32_t value) {
+    if (value < NSub) {
+      return value;
+    }
+    int msb = 31;
+    while ((value >> msb) == 0) {
+      --msb;
+    }
+    int shift = msb - SubBits;
+    return (shift + 1) * NSub + ((value >> shift) & (NSub - 1));
+  }
+
+  static uint32_t bucketUpper(size_t i) {
+    if (i < NSub) {
+      return i;
+    }
+    int shift = i / NSub - 1;
+    uint64_t lower = static_cast<uint64_t>(NSub + i % NSub) << shift;
+    return static_cast<uint32_t>(lower + (uint64_t(1) << shift) - 1);
+  }
+
+private:
+  uint32_t m_buckets[NBuckets] = {};
+  uint32_t m_count = 0;
+  uint64_t m_sum = 0;
+  uint32_t m_min = std::numeric_limits<uint32_t>::max();
+  uint32_t m_max = 0;
+};
+
+} // namespace ping
+
+/**
+ * @brief Periodically transmit Interests to measure round-trip time.
+ * @tparam maxProbes maximum number of outstanding probes.
+ *
+ * Unlike PingClient, this client keeps track of up to @p maxProbes outstanding probes keyed by
+ * sequence number, so that interval may be shorter than RTT. A probe that is not answered
+ * within the timeout, or is displaced by a newer probe when the window is full, is counted as
+ * a timeout.
+ */
+template<int maxProbes = 64>
+class BasicConcurrentPingClient : public PacketHandler {
+public:
+  struct Options {
+    /** @brief Interest interval in milliseconds. */
+    int interval = 1000;
+
+    /** @brief Probe timeout in milliseconds, also used as InterestLifetime. */
+    int timeout = 1000;
+
+    /**
+     * @brief Whether to limit pending probes with a congestion window.
+     *
+     * The window is reduced upon timeout or a Data carrying CongestionMark.
+     * Set @c interval to zero to send probes as fast as the window allows.
+     */
+    bool congestionControl = false;
+
+    /** @brief Congestion window options; maxCwnd is further limited by @p maxProbes . */
+    CongestionWindow::Options cwnd;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param prefix name prefix to request. It should have 'ping' suffix.
+   * @param face face for communication.
+   * @param opts options.
+   */
+  explicit BasicConcurrentPingClient(Name prefix, Face& face, Options opts)
+    : PacketHandler(face)
+    , m_prefix(std::move(prefix))
+    , m_opts(opts)
+    , m_next(port::Clock::add(port::Clock::now(), opts.interval))
+    , m_cwnd(makeCwndOptions(opts.cwnd)) {
+    port::RandomSource::generate(reinterpret_cast<uint8_t*>(&m_nextSeqNum),
+                                 sizeof(m_nextSeqNum));
+    m_oldestSeqNum = m_nextSeqNum;
+  }
+
+  explicit BasicConcurrentPingClient(Name prefix, Face& face)
+    : BasicConcurrentPingClient(std::move(prefix), face, Options()) {}
+
+  struct Counters {
+    uint32_t nTxInterests = 0;
+    uint32_t nRxData = 0;
+    uint32_t nTimeouts = 0;
+    uint32_t nCongestionMarks = 0;
+  };
+
+  Counters readCounters() const {
+    return m_cnt;
+  }
+
+  /** @brief Access RTT histogram, in microseconds. */
+  const ping::RttHistogram& getRtt() const {
+    return m_rtt;
+  }
+
+  /** @brief Return number of outstanding probes. */
+  int countOutstanding() const {
+    return static_cast<int>(m_nextSeqNum - m_oldestSeqNum);
+  }
+
+  /** @brief Return congestion window in packets. */
+  int getCwnd() const {
+    return m_cwnd.get();
+  }
+
+private:
+  struct Probe {
+    port::Clock::Time sent;
+    bool pending = false;
+  };
+
+  Probe& getProbe(uint64_t seqNum) {
+    return m_probes[seqNum % maxProbes];
+  }
+
+  static CongestionWindow::Options makeCwndOptions(CongestionWindow::Options opts) {
+    opts.maxCwnd = std::min(opts.maxCwnd, maxProbes);
+    return opts;
+  }
+
+  void loop() final {
+    auto now = port::Clock::now();
+    expireProbes(now);
+
+    if (port::Clock::isBefore(now, m_next)) {
+      return;
+    }
+    if (m_opts.congestionControl && !m_cwnd.canSend(m_nPending)) {
+      return;
+    }
+    if (countOutstanding() >= maxProbes) {
+      retireProbe();
+    }
+    sendInterest(now);
+    m_next = port::Clock::add(now, m_opts.interval);
+  }
+
+  void expireProbes(port::Clock::Time now) {
+    while (m_oldestSeqNum != m_nextSeqNum) {
+      const Probe& probe = getProbe(m_oldestSeqNum);
+      if (probe.pending && port::Clock::sub(now, probe.sent) < m_opts.timeout) {
+        break;
+      }
+      retireProbe();
+    }
+  }
+
+  void retireProbe() {
+    uint64_t seqNum = m_oldestSeqNum++;
+    Probe& probe = getProbe(seqNum);
+    if (probe.pending) {
+      probe.pending = false;
+      --m_nPending;
+      ++m_cnt.nTimeouts;
+      m_cwnd.decrease(seqNum, m_nextSeqNum);
+    }
+  }
+
+  bool sendInterest(port::Clock::Time now) {
+    uint64_t seqNum = m_nextSeqNum;
+    StaticRegion<1024> region;
+    Component seqNumComp = Component::from(region, TT::GenericNameComponent, tlv::NNI8(seqNum));
+    NDNPH_ASSERT(!!seqNumComp);
+    Name name = m_prefix.append(region, seqNumComp);
+    NDNPH_ASSERT(!!name);
+
+    Interest interest = region.create<Interest>();
+    NDNPH_ASSERT(!!interest);
+    interest.setName(name);
+    interest.setMustBeFresh(true);
+    interest.setLifetime(std::min(m_opts.timeout, 0xFFFF));
+
+    Probe& probe = getProbe(seqNum);
+    probe.sent = now;
+    probe.pending = true;
+    ++m_nPending;
+    ++m_nextSeqNum;
+    ++m_cnt.nTxInterests;
+    return send(interest);
+  }
+
+  bool processData(Data data) final {
+    const Name& dataName = data.getName();
+    if (!m_prefix.isPrefixOf(dataName) || m_prefix.size() + 1 != dataName.size()) {
+      return false;
+    }
+    Component lastComp = dataName[-1];
+    Decoder::Tlv d;
+    Decoder::readTlv(d, lastComp.tlv(), lastComp.tlv() + lastComp.size());
+    uint64_t seqNum = 0;
+    if (!tlv::NNI8::decode(d, seqNum)) {
+      return false;
+    }
+
+    if (seqNum - m_oldestSeqNum >= m_nextSeqNum - m_oldestSeqNum) {
+      return true;
+    }
+    Probe& probe = getProbe(seqNum);
+    if (probe.pending) {
+      probe.pending = false;
+      --m_nPending;
+      ++m_cnt.nRxData;
+      const PacketInfo* pi = getCurrentPacketInfo();
+      if (pi != nullptr && pi->congestionMark > 0) {
+        ++m_cnt.nCongestionMarks;
+        m_cwnd.decrease(seqNum, m_nextSeqNum);
+      } else {
+        m_cwnd.increase();
+      }
+      int64_t rtt = port::Clock::subMicros(port::Clock::now(), probe.sent);
+      m_rtt.add(static_cast<uint32_t>(
+        std::min<int64_t>(std::max<int64_t>(rtt, 0), std::numeric_limits<uint32_t>::max())));
+    }
+    return true;
+  }
+
+private:
+  Name m_prefix;
+  Options m_opts;
+  port::Clock::Time m_next;
+  uint64_t m_nextSeqNum = 0;
+  uint64_t m_oldestSeqNum = 0;
+  Probe m_probes[maxProbes];
+  int m_nPending = 0;
+  CongestionWindow m_cwnd;
+  Counters m_cnt;
+  ping::RttHistogram m_rtt;
+};
+
+using ConcurrentPingClient = BasicConcurrentPingClient<>;
+
 } // namespace ndnph
 
 #endif // NDNPH_APP_PING_CLIENT_HPP
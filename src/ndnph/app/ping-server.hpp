@@ -39,6 +39,118 @@ private:
   const PrivateKey& m_signer;
 };
 
+/**
+ * @brief Respond to every incoming Interest with Data, using a pre-encoded template.
+ * @tparam regionCap encoding region capacity, which must fit the Data packet with LpPacket header.
+ *
+ * The template contains MetaInfo, Content, and SignatureInfo of a DigestKey-signed Data packet.
+ * For each Interest, only the Name TLV is written and the SHA-256 digest is recomputed, so that
+ * the response is identical to what PingServer with DigestKey would produce.
+ */
+template<size_t regionCap = 2048>
+class BasicFastPingServer : public PacketHandler {
+public:
+  /**
+   * @brief Constructor.
+   * @param prefix name prefix to serve. It should have 'ping' suffix.
+   * @param face face for communication.
+   * @param content Data payload; it is copied into the template.
+   * @param freshnessPeriod Data FreshnessPeriod in milliseconds.
+   */
+  explicit BasicFastPingServer(Name prefix, Face& face, tlv::Value content = tlv::Value(),
+                               uint32_t freshnessPeriod = 1)
+    : PacketHandler(face)
+    , m_prefix(std::move(prefix)) {
+    DynamicRegion region(content.size() + 256);
+    Data data = region.create<Data>();
+    NDNPH_ASSERT(!!data);
+    data.setFreshnessPeriod(freshnessPeriod);
+    data.setContent(content);
+
+    Encoder encoder(region);
+    bool ok = encoder.prepend(data.sign(DigestKey::get()));
+    NDNPH_ASSERT(ok);
+    encoder.trim();
+
+    // Data TLV with empty Name: 06 L 07 00 <MetaInfo Content SigInfo> 17 20 <digest>
+    Decoder::Tlv d;
+    ok = Decoder::readTlv(d, encoder.begin(), encoder.end()) && d.length >= 2 + SigSize::value;
+    NDNPH_ASSERT(ok);
+    NDNPH_ASSERT(d.value[0] == TT::Name && d.value[1] == 0);
+    m_suffixLen = d.length - 2 - SigSize::value;
+    m_suffix.reset(new uint8_t[m_suffixLen]);
+    std::copy_n(d.value + 2, m_suffixLen, m_suffix.get());
+    encoder.discard();
+  }
+
+  struct Counters {
+    uint32_t nTxData = 0;
+  };
+
+  Counters readCounters() const {
+    return m_cnt;
+  }
+
+private:
+  using SigSize = std::integral_constant<size_t, 2 + NDNPH_SHA256_LEN>;
+
+  /** @brief Encodable that writes a Data packet from the template. */
+  class Reply {
+  public:
+    explicit Reply(const BasicFastPingServer& server, const Name& name)
+      : m_server(server)
+      , m_name(name) {}
+
+    void encodeTo(Encoder& encoder) const {
+      const uint8_t* afterData = encoder.begin();
+      uint8_t* sig = encoder.prependRoom(NDNPH_SHA256_LEN);
+      encoder.prependTypeLength(TT::DSigValue, NDNPH_SHA256_LEN);
+      const uint8_t* afterSignedPortion = encoder.begin();
+      uint8_t* suffix = encoder.prependRoom(m_server.m_suffixLen);
+      uint8_t* name = encoder.prependRoom(m_name.length());
+      encoder.prependTypeLength(TT::Name, m_name.length());
+      if (!encoder) {
+        return;
+      }
+      std::copy_n(m_server.m_suffix.get(), m_server.m_suffixLen, suffix);
+      std::copy_n(m_name.value(), m_name.length(), name);
+
+      port::Sha256 hash;
+      hash.update(encoder.begin(), afterSignedPortion - encoder.begin());
+      if (!hash.final(sig)) {
+        encoder.setError();
+        return;
+      }
+      encoder.prependTypeLength(TT::Data, afterData - encoder.begin());
+    }
+
+  private:
+    const BasicFastPingServer& m_server;
+    const Name& m_name;
+  };
+
+  bool processInterest(Interest interest) final {
+    const Name& name = interest.getName();
+    if (!m_prefix.isPrefixOf(name)) {
+      return false;
+    }
+
+    StaticRegion<regionCap> region;
+    if (reply(region, Reply(*this, name))) {
+      ++m_cnt.nTxData;
+    }
+    return true;
+  }
+
+private:
+  Name m_prefix;
+  std::unique_ptr<uint8_t[]> m_suffix;
+  size_t m_suffixLen = 0;
+  Counters m_cnt;
+};
+
+using FastPingServer = BasicFastPingServer<>;
+
 } // namespace ndnph
 
 #endif // NDNPH_APP_PING_SERVER_HPP
@@ -4,6 +4,7 @@
 #include "../face/packet-handler.hpp"
 #include "../keychain/null.hpp"
 #include "../port/clock/port.hpp"
+#include "segment-manifest.hpp"
 
 namespace ndnph {
 
@@ -17,6 +18,16 @@ public:
 
     /** @brief Delay in milliseconds before retransmission. */
     int retxDelay = 500;
+
+    /**
+     * @brief Manifest-based verification setting.
+     *
+     * If false, every segment is verified with @c verifier .
+     * If true, the first manifest segment is verified with @c verifier , and other segments are
+     * verified against implicit digests listed in manifest segments.
+     * This must match the producer setting.
+     */
+    bool manifest = false;
   };
 
   /**
@@ -110,6 +121,9 @@ public:
     m_prefix = prefix;
     m_running = true;
     m_segment = 0;
+    m_manifestSegment = 0;
+    m_manifestPos = m_manifestSize = 0;
+    m_wantManifest = m_opts.manifest;
     m_pending.expireNow();
     m_retxRemain = m_opts.retxLimit;
   }
@@ -144,6 +158,19 @@ protected:
   OutgoingPendingInterest m_pending;
   int m_retxRemain = 0;
   bool m_running = false;
+
+  /** @brief Whether the next expected packet is a manifest segment. */
+  bool m_wantManifest = false;
+  /** @brief Whether the current manifest segment is the final manifest segment. */
+  bool m_isFinalManifest = false;
+  uint64_t m_manifestSegment = 0;
+  /** @brief Data segment digests in current manifest segment. */
+  std::unique_ptr<uint8_t[]> m_manifest;
+  size_t m_manifestCap = 0;
+  size_t m_manifestSize = 0;
+  size_t m_manifestPos = 0;
+  /** @brief Expected digest of next manifest segment. */
+  uint8_t m_manifestLink[segment::ManifestEntrySize::value];
 };
 
 /**
@@ -171,14 +198,32 @@ private:
     StaticRegion<regionCap> region;
     Interest interest = region.template create<Interest>();
     NDNPH_ASSERT(!!interest);
-    interest.setName(m_prefix.append(region, SegmentConvention(), m_segment));
+    interest.setName(makeInterestName(region));
     m_pending.send(interest, m_opts.retxDelay);
   }
 
+  Name makeInterestName(Region& region) const {
+    if (m_wantManifest) {
+      return m_prefix.append(region, segment::getManifestComponent(), SegmentConvention(),
+                             m_manifestSegment);
+    }
+    return m_prefix.append(region, SegmentConvention(), m_segment);
+  }
+
   bool processData(Data data) final {
     StaticRegion<regionCap> region;
-    Name interestName = m_prefix.append(region, SegmentConvention(), m_segment);
-    if (!m_pending.match(data, interestName, false) || !data.verify(m_opts.verifier)) {
+    if (!m_pending.match(data, makeInterestName(region), false)) {
+      return false;
+    }
+
+    if (m_wantManifest) {
+      return processManifest(data);
+    }
+
+    if (m_opts.manifest
+          ? !segment::checkManifestEntry(
+              data, &m_manifest[m_manifestPos * segment::ManifestEntrySize::value])
+          : !data.verify(m_opts.verifier)) {
       return false;
     }
 
@@ -186,11 +231,58 @@ private:
 
     if (data.getIsFinalBlock()) {
       m_running = false;
-    } else {
-      ++m_segment;
-      m_pending.expireNow();
-      m_retxRemain = m_opts.retxLimit;
+      return true;
+    }
+
+    ++m_segment;
+    if (m_opts.manifest && ++m_manifestPos == m_manifestSize) {
+      if (m_isFinalManifest) {
+        return fail();
+      }
+      m_wantManifest = true;
+    }
+    m_pending.expireNow();
+    m_retxRemain = m_opts.retxLimit;
+    return true;
+  }
+
+  bool processManifest(Data data) {
+    if (m_manifestSegment == 0 ? !data.verify(m_opts.verifier)
+                               : !segment::checkManifestEntry(data, m_manifestLink)) {
+      return false;
+    }
+
+    auto content = data.getContent();
+    m_isFinalManifest = data.getIsFinalBlock();
+    size_t nEntries = content.size() / segment::ManifestEntrySize::value;
+    if (content.size() % segment::ManifestEntrySize::value != 0 ||
+        nEntries <= static_cast<size_t>(!m_isFinalManifest)) {
+      return fail();
+    }
+
+    if (!m_isFinalManifest) {
+      --nEntries;
+      std::copy_n(content.end() - sizeof(m_manifestLink), sizeof(m_manifestLink),
+                  m_manifestLink);
     }
+    if (nEntries > m_manifestCap) {
+      m_manifestCap = nEntries;
+      m_manifest.reset(new uint8_t[m_manifestCap * segment::ManifestEntrySize::value]);
+    }
+    std::copy_n(content.begin(), nEntries * segment::ManifestEntrySize::value, m_manifest.get());
+    m_manifestSize = nEntries;
+    m_manifestPos = 0;
+
+    ++m_manifestSegment;
+    m_wantManifest = false;
+    m_pending.expireNow();
+    m_retxRemain = m_opts.retxLimit;
+    return true;
+  }
+
+  bool fail() {
+    m_running = false;
+    invokeCallback(Data());
     return true;
   }
 };
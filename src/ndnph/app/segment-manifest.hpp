@@ -0,0 +1,65 @@
+#ifndef NDNPH_APP_SEGMENT_MANIFEST_HPP
+#define NDNPH_APP_SEGMENT_MANIFEST_HPP
+
+#include "../packet/data.hpp"
+
+namespace ndnph {
+namespace segment {
+
+/** @brief Return '32=manifest' component. */
+inline Component
+getManifestComponent() {
+  static const uint8_t tlv[]{0x20, 0x08, 'm', 'a', 'n', 'i', 'f', 'e', 's', 't'};
+  static Component comp = Component::constant(tlv, sizeof(tlv));
+  return comp;
+}
+
+/**
+ * @brief Size of a manifest entry.
+ *
+ * Manifest Content is a sequence of ImplicitSha256DigestComponent TLVs.
+ * Manifest segment i lists implicit digests of data segments covered by it, followed by implicit
+ * digest of manifest segment i+1 unless it is the final manifest segment. Only manifest segment 0
+ * carries an asymmetric signature; the rest of the object is authenticated through the chain.
+ */
+using ManifestEntrySize = std::integral_constant<size_t, 2 + NDNPH_SHA256_LEN>;
+
+/**
+ * @brief Compute how many data segments are covered by each manifest segment.
+ * @param contentLen maximum Content TLV-VALUE length in each segment.
+ */
+inline size_t
+computeManifestCapacity(size_t contentLen) {
+  return std::max<size_t>(contentLen / ManifestEntrySize::value, 2) - 1;
+}
+
+/**
+ * @brief Write a manifest entry from a Data packet.
+ * @param data decoded Data packet.
+ * @param[out] entry buffer of ManifestEntrySize.
+ * @return whether success.
+ */
+inline bool
+writeManifestEntry(const Data& data, uint8_t* entry) {
+  entry[0] = TT::ImplicitSha256DigestComponent;
+  entry[1] = NDNPH_SHA256_LEN;
+  return data.computeImplicitDigest(&entry[2]);
+}
+
+/**
+ * @brief Check a Data packet against a manifest entry.
+ * @param data decoded Data packet.
+ * @param entry manifest entry, which is an ImplicitSha256DigestComponent TLV.
+ */
+inline bool
+checkManifestEntry(const Data& data, const uint8_t* entry) {
+  uint8_t digest[NDNPH_SHA256_LEN];
+  return entry[0] == TT::ImplicitSha256DigestComponent && entry[1] == NDNPH_SHA256_LEN &&
+         data.computeImplicitDigest(digest) &&
+         port::TimingSafeEqual()(digest, sizeof(digest), &entry[2], NDNPH_SHA256_LEN);
+}
+
+} // namespace segment
+} // namespace ndnph
+
+#endif // NDNPH_APP_SEGMENT_MANIFEST_HPP
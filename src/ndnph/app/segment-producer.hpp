@@ -3,6 +3,9 @@
 
 #include "../face/packet-handler.hpp"
 #include "../keychain/digest.hpp"
+#include "../port/fs/port.hpp"
+#include "../port/queue/port.hpp"
+#include "segment-manifest.hpp"
 
 namespace ndnph {
 
@@ -28,6 +31,16 @@ public:
      *      omit these two components, achieving a simple form of version discovery.
      */
     int discovery = 2;
+
+    /**
+     * @brief Manifest-based signing setting.
+     *
+     * If false, every segment is signed with @c signer .
+     * If true, segments are signed with DigestKey and authenticated through a chain of manifest
+     * segments, in which only the first manifest segment is signed with @c signer .
+     * @sa segment-manifest.hpp
+     */
+    bool manifest = false;
   };
 
   /**
@@ -54,6 +67,40 @@ public:
     m_content = content;
     m_size = size;
     m_lastSegment = divCeil(std::max(size, static_cast<size_t>(1)), m_opts.contentLen) - 1;
+    afterSetContent();
+  }
+
+protected:
+  /** @brief Notify that served content has been set or changed. */
+  virtual void afterSetContent() {}
+
+  /**
+   * @brief Notify that a segment is about to be served.
+   * @param segment segment number, not exceeding @c m_lastSegment .
+   */
+  virtual void beforeReplySegment(uint64_t segment) {
+    (void)segment;
+  }
+
+  /**
+   * @brief Find a signed segment that was prepared in advance.
+   * @param segment segment number, not exceeding @c m_lastSegment .
+   * @return encoded Data packet; empty value to sign the segment upon request.
+   */
+  virtual tlv::Value findSignedSegment(uint64_t segment) {
+    (void)segment;
+    return tlv::Value();
+  }
+
+  /** @brief Get the key for signing data segments. */
+  const PrivateKey& getSegmentSigner() const {
+    return m_opts.manifest ? DigestKey::get() : m_opts.signer;
+  }
+
+  /** @brief Get Content of a segment. */
+  tlv::Value getSegmentContent(uint64_t segment) const {
+    return tlv::Value(m_content + m_opts.contentLen * segment,
+                      m_content + std::min<size_t>(m_opts.contentLen * (segment + 1), m_size));
   }
 
 protected:
@@ -74,7 +121,87 @@ class BasicSegmentProducer : public SegmentProducerBase {
 public:
   using SegmentProducerBase::SegmentProducerBase;
 
+protected:
+  /** @brief Create unsigned Data packet of a segment. */
+  Data makeSegment(Region& region, const Name& prefix, uint64_t segment, bool isFinalBlock,
+                   tlv::Value content) const {
+    Data data = region.template create<Data>();
+    if (!data) {
+      return data;
+    }
+    data.setName(prefix.append(region, SegmentConvention(), segment));
+    data.setFreshnessPeriod(m_opts.freshnessPeriod);
+    data.setIsFinalBlock(isFinalBlock);
+    data.setContent(std::move(content));
+    return data;
+  }
+
+  /** @brief Prepare manifest segments, if enabled. */
+  void afterSetContent() override {
+    m_manifest.reset();
+    if (!m_opts.manifest || m_content == nullptr) {
+      return;
+    }
+
+    m_manifestCapacity = segment::computeManifestCapacity(m_opts.contentLen);
+    uint64_t nSegments = m_lastSegment + 1;
+    m_lastManifest = divCeil(nSegments, m_manifestCapacity) - 1;
+    size_t stride = (m_manifestCapacity + 1) * segment::ManifestEntrySize::value;
+    m_manifest.reset(new uint8_t[stride * (m_lastManifest + 1)]);
+
+    for (uint64_t segment = 0; segment <= m_lastSegment; ++segment) {
+      StaticRegion<regionCap> region;
+      Data data = makeSegment(region, m_prefix, segment, segment == m_lastSegment,
+                              getSegmentContent(segment));
+      bool ok = computeManifestEntry(region, data, getManifestEntry(segment));
+      NDNPH_ASSERT(ok);
+    }
+
+    // each manifest segment contains the digest of its successor, so they are digested backwards
+    for (uint64_t manifest = m_lastManifest; manifest > 0; --manifest) {
+      StaticRegion<regionCap> region;
+      Data data = makeManifest(region, manifest);
+      bool ok = computeManifestEntry(region, data,
+                                     &m_manifest[stride * (manifest - 1) +
+                                                 m_manifestCapacity *
+                                                   segment::ManifestEntrySize::value]);
+      NDNPH_ASSERT(ok);
+    }
+  }
+
 private:
+  uint8_t* getManifestEntry(uint64_t segment) const {
+    uint64_t manifest = segment / m_manifestCapacity;
+    uint64_t index = manifest * (m_manifestCapacity + 1) + segment % m_manifestCapacity;
+    return &m_manifest[index * segment::ManifestEntrySize::value];
+  }
+
+  static bool computeManifestEntry(Region& region, Data data, uint8_t* entry) {
+    Data decoded = region.template create<Data>();
+    return !!data && !!decoded && decoded.decodeFrom(data.sign(DigestKey::get())) &&
+           segment::writeManifestEntry(decoded, entry);
+  }
+
+  /** @brief Create unsigned Data packet of a manifest segment. */
+  Data makeManifest(Region& region, uint64_t manifest) const {
+    Data data = region.template create<Data>();
+    if (!data) {
+      return data;
+    }
+    bool isFinalBlock = manifest == m_lastManifest;
+    uint64_t firstSegment = manifest * m_manifestCapacity;
+    size_t nEntries = std::min<uint64_t>(m_manifestCapacity, m_lastSegment + 1 - firstSegment) +
+                      static_cast<size_t>(!isFinalBlock);
+    const uint8_t* entries = getManifestEntry(firstSegment);
+
+    data.setName(
+      m_prefix.append(region, segment::getManifestComponent(), SegmentConvention(), manifest));
+    data.setFreshnessPeriod(m_opts.freshnessPeriod);
+    data.setIsFinalBlock(isFinalBlock);
+    data.setContent(tlv::Value(entries, nEntries * segment::ManifestEntrySize::value));
+    return data;
+  }
+
   bool processInterest(Interest interest) final {
     if (!m_prefix || m_content == nullptr) {
       return false;
@@ -82,6 +209,16 @@ private:
 
     const Name& interestName = interest.getName();
     size_t dataNameSize = m_prefix.size() + 1;
+    if (m_manifest != nullptr && interestName.size() == dataNameSize + 1) {
+      auto lastComp = interestName[-1];
+      if (!m_prefix.isPrefixOf(interestName) ||
+          interestName[-2] != segment::getManifestComponent() ||
+          !lastComp.is<SegmentConvention>()) {
+        return false;
+      }
+      return replyManifest(lastComp.as<SegmentConvention>());
+    }
+
     if (interestName.size() == dataNameSize) {
       auto lastComp = interestName[-1];
       if (!m_prefix.isPrefixOf(interestName) || !lastComp.is<SegmentConvention>()) {
@@ -101,23 +238,310 @@ private:
     if (segment > m_lastSegment) {
       return true;
     }
+    beforeReplySegment(segment);
 
     StaticRegion<regionCap> region;
-    Data data = region.template create<Data>();
+    tlv::Value wire = findSignedSegment(segment);
+    if (wire) {
+      reply(region, wire);
+      return true;
+    }
+
+    Data data = makeSegment(region, m_prefix, segment, segment == m_lastSegment,
+                            getSegmentContent(segment));
     NDNPH_ASSERT(!!data);
-    data.setName(m_prefix.append(region, SegmentConvention(), segment));
-    data.setFreshnessPeriod(m_opts.freshnessPeriod);
-    data.setIsFinalBlock(segment == m_lastSegment);
-    data.setContent(
-      tlv::Value(m_content + m_opts.contentLen * segment,
-                 m_content + std::min<size_t>(m_opts.contentLen * (segment + 1), m_size)));
-    reply(data.sign(m_opts.signer));
+    reply(data.sign(getSegmentSigner()));
+    return true;
+  }
+
+  bool replyManifest(uint64_t manifest) {
+    if (manifest > m_lastManifest) {
+      return true;
+    }
+
+    StaticRegion<regionCap> region;
+    Data data = makeManifest(region, manifest);
+    NDNPH_ASSERT(!!data);
+    reply(data.sign(manifest == 0 ? m_opts.signer : DigestKey::get()));
     return true;
   }
+
+private:
+  std::unique_ptr<uint8_t[]> m_manifest;
+  uint64_t m_manifestCapacity = 1;
+  uint64_t m_lastManifest = 0;
 };
 
 using SegmentProducer = BasicSegmentProducer<>;
 
+/**
+ * @brief Producer of segmented object served from a file.
+ * @tparam SegmentConvention segment component convention.
+ * @tparam regionCap encoding region capacity.
+ *
+ * The file is mapped read-only, and Content of each segment references the mapping directly.
+ * When segments are requested sequentially, pages ahead of the requested segment are prefetched
+ * and pages far behind are released, so that resident memory stays bounded regardless of file
+ * size.
+ */
+template<typename SegmentConvention = convention::Segment, size_t regionCap = 2048>
+class BasicFileSegmentProducer : public BasicSegmentProducer<SegmentConvention, regionCap> {
+public:
+  using BasicSegmentProducer<SegmentConvention, regionCap>::BasicSegmentProducer;
+
+  /**
+   * @brief Set or change served content to a file.
+   * @param prefix name prefix. This should end with version component, if desired.
+   * @tparam Arg arguments passed to @c port::FileMapping::open() function,
+   *             such as file path or file descriptor.
+   * @return whether success. If false, no content is served.
+   * @note prefix must be kept alive until setFile() is called again.
+   */
+  template<typename... Arg>
+  bool setFile(Name prefix, Arg&&... arg) {
+    this->setContent(Name(), nullptr, 0);
+    if (!m_file.open(std::forward<Arg>(arg)...)) {
+      return false;
+    }
+    m_file.advise(port::FileMapping::AdviceSequential);
+
+    static const uint8_t emptyContent[1] = {0};
+    const uint8_t* content = m_file.data();
+    this->setContent(prefix, content == nullptr ? emptyContent : content, m_file.size());
+    m_nextSegment = 0;
+    return true;
+  }
+
+  /**
+   * @brief Set number of segments to prefetch ahead of a sequential consumer.
+   *
+   * Pages more than this number of segments behind the requested segment are released.
+   */
+  void setReadahead(uint16_t nSegments) {
+    m_readahead = nSegments;
+  }
+
+private:
+  void beforeReplySegment(uint64_t segment) final {
+    bool isSequential = segment == m_nextSegment;
+    m_nextSegment = segment + 1;
+    if (!isSequential || m_readahead == 0) {
+      return;
+    }
+
+    size_t windowLen = this->m_opts.contentLen * m_readahead;
+    size_t offset = this->m_opts.contentLen * segment;
+    if (segment % m_readahead == 0) {
+      m_file.advise(offset + this->m_opts.contentLen, windowLen,
+                    port::FileMapping::AdviceWillNeed);
+      if (offset >= 2 * windowLen) {
+        m_file.advise(offset - 2 * windowLen, windowLen, port::FileMapping::AdviceDontNeed);
+      }
+    }
+  }
+
+private:
+  port::FileMapping m_file;
+  uint64_t m_nextSegment = 0;
+  uint16_t m_readahead = 64;
+};
+
+using FileSegmentProducer = BasicFileSegmentProducer<>;
+
+/**
+ * @brief Producer of segmented object, where segments are signed by a pool of workers.
+ * @tparam SegmentConvention segment component convention.
+ * @tparam regionCap encoding region capacity.
+ * @tparam nWorkers number of signing workers.
+ * @tparam queueCap maximum number of outstanding segments per worker.
+ *
+ * After content is set, every segment is scheduled for signing on the workers. The application
+ * should invoke @c work(i) repeatedly in a dedicated thread for each worker index @c i .
+ * Each worker signs segments with its own Region and Encoder, and hands over the encoded Data to
+ * the Face thread through a @c port::SafeQueue . Signed segments are collected during
+ * @c Face::loop() and replied without further signing. A segment requested before it has been
+ * signed by a worker is signed on the Face thread as usual.
+ *
+ * Options::signer is invoked concurrently from worker threads, so that it must be thread-safe.
+ * When content is changed, previous content must be kept alive until countOutstanding() reaches
+ * zero, because workers may still be reading it. Worker threads must be stopped before the
+ * producer is destructed.
+ */
+template<typename SegmentConvention = convention::Segment, size_t regionCap = 2048,
+         int nWorkers = 4, size_t queueCap = 16>
+class BasicParallelSegmentProducer : public BasicSegmentProducer<SegmentConvention, regionCap> {
+public:
+  using BasicSegmentProducer<SegmentConvention, regionCap>::BasicSegmentProducer;
+
+  ~BasicParallelSegmentProducer() override {
+    for (auto& worker : m_workers) {
+      bool ok = false;
+      do {
+        Result result;
+        std::tie(result, ok) = worker.resultQ.pop();
+        delete[] result.wire;
+      } while (ok);
+    }
+    clearCache();
+  }
+
+  /**
+   * @brief Sign one scheduled segment on a worker.
+   * @param i worker index, between 0 and nWorkers-1.
+   * @return whether a segment has been processed.
+   *
+   * This should be invoked repeatedly in a dedicated thread for each worker index.
+   * It must not be invoked concurrently with the same worker index.
+   */
+  bool work(int i) {
+    Worker& worker = m_workers[i];
+    Task task;
+    bool ok = false;
+    std::tie(task, ok) = worker.taskQ.pop();
+    if (!ok) {
+      return false;
+    }
+
+    Result result;
+    result.generation = task.generation;
+    result.segment = task.segment;
+
+    StaticRegion<regionCap> region;
+    Data data = this->makeSegment(region, task.prefix, task.segment, task.isFinalBlock,
+                                  task.content);
+    Encoder encoder(region);
+    if (!!data && encoder.prepend(data.sign(this->getSegmentSigner()))) {
+      result.wire = new uint8_t[encoder.size()];
+      result.size = encoder.size();
+      std::copy(encoder.begin(), encoder.end(), result.wire);
+    }
+
+    ok = worker.resultQ.push(result);
+    NDNPH_ASSERT(ok);
+    return true;
+  }
+
+  /** @brief Count segments handed to workers but not yet collected by the Face thread. */
+  size_t countOutstanding() const {
+    size_t n = 0;
+    for (const auto& worker : m_workers) {
+      n += worker.nOutstanding;
+    }
+    return n;
+  }
+
+  /** @brief Determine whether every segment of current content has been signed. */
+  bool isComplete() const {
+    return m_content != nullptr && m_nSigned == m_lastSegment + 1;
+  }
+
+private:
+  using SegmentProducerBase::m_content;
+  using SegmentProducerBase::m_lastSegment;
+
+  struct Task {
+    Name prefix;
+    tlv::Value content;
+    uint64_t segment = 0;
+    uint32_t generation = 0;
+    bool isFinalBlock = false;
+  };
+
+  struct Result {
+    uint8_t* wire = nullptr;
+    size_t size = 0;
+    uint64_t segment = 0;
+    uint32_t generation = 0;
+  };
+
+  struct Worker {
+    port::SafeQueue<Task, queueCap> taskQ;
+    port::SafeQueue<Result, queueCap> resultQ;
+    size_t nOutstanding = 0;
+  };
+
+  void afterSetContent() final {
+    BasicSegmentProducer<SegmentConvention, regionCap>::afterSetContent();
+    ++m_generation;
+    clearCache();
+    if (m_content == nullptr) {
+      return;
+    }
+    m_cacheSize = m_lastSegment + 1;
+    m_cache.reset(new tlv::Value[m_cacheSize]);
+    m_nextTask = 0;
+  }
+
+  tlv::Value findSignedSegment(uint64_t segment) final {
+    if (segment >= m_cacheSize) {
+      return tlv::Value();
+    }
+    return m_cache[segment];
+  }
+
+  void loop() final {
+    for (auto& worker : m_workers) {
+      collectResults(worker);
+      scheduleTasks(worker);
+    }
+  }
+
+  void collectResults(Worker& worker) {
+    for (;;) {
+      Result result;
+      bool ok = false;
+      std::tie(result, ok) = worker.resultQ.pop();
+      if (!ok) {
+        break;
+      }
+      --worker.nOutstanding;
+
+      if (result.generation != m_generation || result.wire == nullptr ||
+          result.segment >= m_cacheSize || !!m_cache[result.segment]) {
+        delete[] result.wire;
+        continue;
+      }
+      m_cache[result.segment] = tlv::Value(result.wire, result.size);
+      ++m_nSigned;
+    }
+  }
+
+  void scheduleTasks(Worker& worker) {
+    for (; m_nextTask < m_cacheSize && worker.nOutstanding < queueCap; ++m_nextTask) {
+      Task task;
+      task.prefix = this->m_prefix;
+      task.content = this->getSegmentContent(m_nextTask);
+      task.segment = m_nextTask;
+      task.generation = m_generation;
+      task.isFinalBlock = m_nextTask == m_lastSegment;
+      if (!worker.taskQ.push(task)) {
+        break;
+      }
+      ++worker.nOutstanding;
+    }
+  }
+
+  void clearCache() {
+    for (uint64_t i = 0; i < m_cacheSize; ++i) {
+      delete[] m_cache[i].begin();
+    }
+    m_cache.reset();
+    m_cacheSize = 0;
+    m_nSigned = 0;
+    m_nextTask = 0;
+  }
+
+private:
+  std::array<Worker, nWorkers> m_workers;
+  std::unique_ptr<tlv::Value[]> m_cache;
+  uint64_t m_cacheSize = 0;
+  uint64_t m_nSigned = 0;
+  uint64_t m_nextTask = 0;
+  uint32_t m_generation = 0;
+};
+
+using ParallelSegmentProducer = BasicParallelSegmentProducer<>;
+
 } // namespace ndnph
 
 #endif // NDNPH_APP_SEGMENT_PRODUCER_HPP
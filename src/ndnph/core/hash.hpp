@@ -0,0 +1,27 @@
+#ifndef NDNPH_CORE_HASH_HPP
+#define NDNPH_CORE_HASH_HPP
+
+#include "common.hpp"
+
+namespace ndnph {
+namespace detail {
+
+/** @brief FNV-1a 32-bit offset basis, i.e. hash of empty input. */
+using Fnv1aBasis = std::integral_constant<uint32_t, 2166136261>;
+
+/**
+ * @brief Compute FNV-1a 32-bit hash over a byte range.
+ * @param h initial state; pass a previous return value to hash a concatenation incrementally.
+ */
+inline uint32_t
+fnv1a(const uint8_t* value, size_t length, uint32_t h = Fnv1aBasis::value) {
+  for (size_t i = 0; i < length; ++i) {
+    h = (h ^ value[i]) * 16777619;
+  }
+  return h;
+}
+
+} // namespace detail
+} // namespace ndnph
+
+#endif // NDNPH_CORE_HASH_HPP
@@ -45,14 +45,24 @@ private:
   }
 
   bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) final {
+    IoVec iov{pkt, pktLen};
+    return doSendv(&iov, 1, endpointId);
+  }
+
+  bool doCanSendv() const final {
+    return true;
+  }
+
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId) final {
     if (m_peer == nullptr) {
       return false;
     }
     if (auto r = m_peer->receiving()) {
+      size_t pktLen = iovLength(iov, iovcnt);
       if (r.bufLen() < pktLen) {
         return false;
       }
-      std::copy_n(pkt, pktLen, r.buf());
+      iovGather(iov, iovcnt, r.buf());
       r(pktLen, endpointId);
       return true;
     }
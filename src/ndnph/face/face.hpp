@@ -2,6 +2,7 @@
 #define NDNPH_FACE_FACE_HPP
 
 #include "../packet/lp.hpp"
+#include "lp-reliability.hpp"
 #include "transport.hpp"
 
 namespace ndnph {
@@ -14,6 +15,7 @@ public:
   struct PacketInfo {
     uint64_t endpointId = 0;
     lp::PitToken pitToken;
+    uint8_t congestionMark = 0;
   };
 
   /**
@@ -65,6 +67,39 @@ public:
     m_reass = &reass;
   }
 
+  /**
+   * @brief Enable NDNLPv2 reassembly that accepts out-of-order fragments.
+   * @param reass reassembler. It must be kept until face is destructed.
+   *
+   * This takes precedence over @c lp::Reassembler .
+   */
+  void setReassembler(lp::MultiReassembler& reass) {
+    m_multiReass = &reass;
+  }
+
+  /**
+   * @brief Enable NDNLPv2 link layer reliability.
+   * @param rel reliability layer. It must be kept until face is destructed.
+   *
+   * If fragmentation is enabled, the fragmenter MTU should be reduced by
+   * @c lp::Reliability::Overhead to leave room for reliability fields.
+   */
+  void setReliability(lp::Reliability& rel) {
+    m_rel = &rel;
+  }
+
+  /**
+   * @brief Enable or disable lazy decoding of incoming Interest and Data.
+   *
+   * When enabled, signature fields are parsed upon first access, which saves work in handlers
+   * that reject most packets by name. A packet with malformed signature fields is then passed
+   * to handlers, but it cannot be verified.
+   * @sa Interest::decodeLazy, Data::decodeLazy
+   */
+  void setLazyDecode(bool enable) {
+    m_lazyDecode = enable;
+  }
+
   /**
    * @brief Add a packet handler.
    * @param prio priority, smaller number means higher priority.
@@ -92,6 +127,14 @@ public:
   template<typename Packet>
   bool send(Region& region, const Packet& packet, PacketInfo pi);
 
+  /**
+   * @brief Synchronously transmit a Data with gathered Content.
+   *
+   * If the transport supports @c Transport::sendv natively, and neither fragmentation nor
+   * reliability is enabled, Content chunks are passed to the transport without copying.
+   */
+  bool send(Region& region, const Data::Gathered& packet, PacketInfo pi);
+
 private:
   class ScopedCurrentPacketInfo {
   public:
@@ -123,8 +166,11 @@ private:
   Transport& m_transport;
   lp::Fragmenter* m_frag = nullptr;
   lp::Reassembler* m_reass = nullptr;
+  lp::MultiReassembler* m_multiReass = nullptr;
+  lp::Reliability* m_rel = nullptr;
   PacketHandler* m_handler = nullptr;
   const PacketInfo* m_currentPacketInfo = nullptr;
+  bool m_lazyDecode = false;
 };
 
 } // namespace ndnph
@@ -0,0 +1,301 @@
+#ifndef NDNPH_FACE_LP_RELIABILITY_HPP
+#define NDNPH_FACE_LP_RELIABILITY_HPP
+
+#include "../packet/lp.hpp"
+#include "transport.hpp"
+
+namespace ndnph {
+namespace lp {
+
+/**
+ * @brief NDNLPv2 link layer reliability.
+ *
+ * Each outgoing LpPacket carries a TxSequence field, and is retained until the peer acknowledges
+ * it. An unacknowledged packet is retransmitted with a new TxSequence after a retransmission
+ * timeout (RTO) derived from RTT samples, up to a limited number of times.
+ * Acks for incoming TxSequence numbers are piggybacked on outgoing packets, or sent in an IDLE
+ * packet if no outgoing packet is available within a short delay.
+ *
+ * This is designed for point-to-point links. IDLE packets are sent toward the endpoint of the
+ * most recently received TxSequence.
+ */
+class Reliability {
+public:
+  /** @brief Octets added to each LpPacket, excluding piggybacked Acks. */
+  using Overhead = std::integral_constant<size_t, 1 + 3 + 3 + 1 + 8>;
+
+  /** @brief Encoded size of an Ack field. */
+  using AckSize = std::integral_constant<size_t, 3 + 1 + 8>;
+
+  struct Options {
+    /** @brief Maximum number of unacknowledged packets. */
+    int maxUnacked = 16;
+
+    /** @brief Maximum output packet size including NDNLPv2 headers. */
+    uint16_t mtu = 1500;
+
+    /** @brief Initial, minimum, and maximum RTO in milliseconds. */
+    int initialRto = 200;
+    int minRto = 20;
+    int maxRto = 4000;
+
+    /** @brief Maximum number of retransmissions of a packet. */
+    int maxRetx = 3;
+
+    /** @brief Maximum delay of a pending Ack in milliseconds. */
+    int ackDelay = 10;
+  };
+
+  struct Counters {
+    uint32_t nTx = 0;
+    uint32_t nRetx = 0;
+    uint32_t nAcked = 0;
+    uint32_t nGiveUps = 0;
+    uint32_t nIdle = 0;
+  };
+
+  explicit Reliability(Options opts)
+    : m_opts(opts)
+    , m_entries(new Entry[m_opts.maxUnacked])
+    , m_buffer(new uint8_t[(m_opts.maxUnacked + 1) * m_opts.mtu])
+    , m_rto(opts.initialRto) {
+    port::RandomSource::generate(reinterpret_cast<uint8_t*>(&m_nextTxSeq), sizeof(m_nextTxSeq));
+  }
+
+  explicit Reliability()
+    : Reliability(Options()) {}
+
+  /**
+   * @brief Transmit a packet and retain it for retransmission.
+   * @param frag packet or fragment; its encoded size plus @c Overhead must fit in MTU.
+   * @return whether success.
+   */
+  bool send(Transport& transport, const Fragmenter::Fragment& frag, uint64_t endpointId = 0) {
+    Entry* entry = nullptr;
+    for (int i = 0; i < m_opts.maxUnacked && entry == nullptr; ++i) {
+      if (!m_entries[i].inUse) {
+        entry = &m_entries[i];
+      }
+    }
+    if (entry == nullptr) {
+      return false;
+    }
+
+    uint8_t* buf = &m_buffer[(entry - &m_entries[0]) * m_opts.mtu];
+    Encoder encoder(buf, m_opts.mtu - Overhead::value);
+    encoder.prependTlv(TT::LpPayload, frag.payload);
+    size_t postSize = encoder.size();
+    frag.encodeL3Header(encoder);
+    if (frag.frag.fragCount > 1) {
+      encoder.prepend(frag.frag);
+    }
+    if (!encoder) {
+      return false;
+    }
+
+    entry->pkt = encoder.begin();
+    entry->preSize = encoder.size() - postSize;
+    entry->postSize = postSize;
+    entry->endpointId = endpointId;
+    entry->nRetx = 0;
+    entry->inUse = transmit(transport, *entry);
+    return entry->inUse;
+  }
+
+  /** @brief Process Ack and TxSequence fields of an incoming LpPacket. */
+  void receive(Transport& transport, const PacketClassify& classify, uint64_t endpointId = 0) {
+    auto now = port::Clock::now();
+    for (const auto& d : classify.getAcks().makeDecoder()) {
+      uint64_t txSeq = 0;
+      if (d.type == TT::Ack && tlv::NNI8::decode(d, txSeq)) {
+        processAck(now, txSeq);
+      }
+    }
+
+    bool hasTxSeq = false;
+    uint64_t txSeq = 0;
+    std::tie(hasTxSeq, txSeq) = classify.getTxSequence();
+    if (!hasTxSeq) {
+      return;
+    }
+    if (m_nAcks == MaxPendingAcks::value) {
+      sendIdle(transport);
+    }
+    if (m_nAcks == 0) {
+      m_ackSince = now;
+    }
+    m_acks[m_nAcks++] = txSeq;
+    m_ackEndpointId = endpointId;
+  }
+
+  /**
+   * @brief Retransmit timed out packets and send pending Acks.
+   *
+   * This must be invoked periodically.
+   */
+  void loop(Transport& transport) {
+    auto now = port::Clock::now();
+    bool hasTimeout = false;
+    for (int i = 0; i < m_opts.maxUnacked; ++i) {
+      Entry& entry = m_entries[i];
+      if (!entry.inUse || port::Clock::sub(now, entry.sentTime) < m_rto) {
+        continue;
+      }
+      hasTimeout = true;
+      if (entry.nRetx >= m_opts.maxRetx) {
+        entry.inUse = false;
+        ++m_cnt.nGiveUps;
+        continue;
+      }
+      ++entry.nRetx;
+      ++m_cnt.nRetx;
+      transmit(transport, entry);
+    }
+    if (hasTimeout) {
+      m_rto = std::min(2 * m_rto, m_opts.maxRto);
+    }
+
+    if (m_nAcks > 0 && port::Clock::sub(now, m_ackSince) >= m_opts.ackDelay) {
+      sendIdle(transport);
+    }
+  }
+
+  /** @brief Count packets awaiting acknowledgement. */
+  int countUnacked() const {
+    int n = 0;
+    for (int i = 0; i < m_opts.maxUnacked; ++i) {
+      n += static_cast<int>(m_entries[i].inUse);
+    }
+    return n;
+  }
+
+  /** @brief Return current RTO in milliseconds. */
+  int getRto() const {
+    return m_rto;
+  }
+
+  Counters readCounters() const {
+    return m_cnt;
+  }
+
+private:
+  /** @brief Retained packet, encoded as LpPacket TLV-VALUE without reliability fields. */
+  struct Entry {
+    const uint8_t* pkt = nullptr;
+    uint64_t endpointId = 0;
+    uint64_t txSeq = 0;
+    port::Clock::Time sentTime;
+    uint16_t preSize = 0; ///< size of fields before TxSequence
+    uint16_t postSize = 0; ///< size of LpPayload
+    uint8_t nRetx = 0;
+    bool inUse = false;
+  };
+
+  using MaxPendingAcks = std::integral_constant<int, 32>;
+
+  bool transmit(Transport& transport, Entry& entry) {
+    entry.txSeq = m_nextTxSeq++;
+    entry.sentTime = port::Clock::now();
+    size_t bodySize = entry.preSize + entry.postSize;
+
+    uint8_t fieldsRoom[Overhead::value + AckSize::value * MaxPendingAcks::value];
+    Encoder fields(fieldsRoom, sizeof(fieldsRoom));
+    fields.prependTlv(TT::TxSequence, tlv::NNI8(entry.txSeq));
+    prependAcks(fields, (m_opts.mtu - Overhead::value - bodySize) / AckSize::value);
+    uint8_t tlRoom[1 + 5];
+    Encoder tl(tlRoom, sizeof(tlRoom));
+    tl.prependTypeLength(TT::LpPacket, fields.size() + bodySize);
+    if (!fields || !tl) {
+      return false;
+    }
+
+    Transport::IoVec iov[] = {
+      {tl.begin(), tl.size()},
+      {entry.pkt, entry.preSize},
+      {fields.begin(), fields.size()},
+      {entry.pkt + entry.preSize, entry.postSize},
+    };
+    ++m_cnt.nTx;
+    if (transport.canSendv()) {
+      return transport.sendv(iov, 4, entry.endpointId);
+    }
+
+    // last MTU-sized slot of m_buffer is scratch space for linearizing the packet
+    uint8_t* pkt = &m_buffer[m_opts.maxUnacked * m_opts.mtu];
+    uint8_t* end = pkt;
+    for (const auto& v : iov) {
+      end = std::copy_n(v.base, v.len, end);
+    }
+    return transport.send(pkt, end - pkt, entry.endpointId);
+  }
+
+  void prependAcks(Encoder& encoder, size_t limit) {
+    for (; m_nAcks > 0 && limit > 0; --limit) {
+      encoder.prependTlv(TT::Ack, tlv::NNI8(m_acks[--m_nAcks]));
+    }
+  }
+
+  void sendIdle(Transport& transport) {
+    while (m_nAcks > 0) {
+      uint8_t room[1 + 5 + AckSize::value * MaxPendingAcks::value];
+      Encoder encoder(room, sizeof(room));
+      prependAcks(encoder, (m_opts.mtu - Overhead::value) / AckSize::value);
+      encoder.prependTypeLength(TT::LpPacket, encoder.size());
+      if (!encoder) {
+        m_nAcks = 0;
+        return;
+      }
+      ++m_cnt.nIdle;
+      transport.send(encoder.begin(), encoder.size(), m_ackEndpointId);
+    }
+  }
+
+  void processAck(port::Clock::Time now, uint64_t txSeq) {
+    for (int i = 0; i < m_opts.maxUnacked; ++i) {
+      Entry& entry = m_entries[i];
+      if (!entry.inUse || entry.txSeq != txSeq) {
+        continue;
+      }
+      if (entry.nRetx == 0) {
+        updateRto(port::Clock::sub(now, entry.sentTime));
+      }
+      entry.inUse = false;
+      ++m_cnt.nAcked;
+      return;
+    }
+  }
+
+  /** @brief Update RTO with an RTT sample, as specified in RFC 6298. */
+  void updateRto(int rtt) {
+    if (m_srtt < 0) {
+      m_srtt = rtt;
+      m_rttvar = rtt / 2;
+    } else {
+      int delta = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+      m_rttvar = (3 * m_rttvar + delta) / 4;
+      m_srtt = (7 * m_srtt + rtt) / 8;
+    }
+    m_rto = std::min(std::max(m_srtt + std::max(1, 4 * m_rttvar), m_opts.minRto), m_opts.maxRto);
+  }
+
+private:
+  Options m_opts;
+  std::unique_ptr<Entry[]> m_entries;
+  std::unique_ptr<uint8_t[]> m_buffer;
+  uint64_t m_nextTxSeq = 0;
+  int m_srtt = -1;
+  int m_rttvar = 0;
+  int m_rto = 0;
+
+  uint64_t m_acks[MaxPendingAcks::value];
+  int m_nAcks = 0;
+  port::Clock::Time m_ackSince;
+  uint64_t m_ackEndpointId = 0;
+
+  Counters m_cnt;
+};
+
+} // namespace lp
+} // namespace ndnph
+
+#endif // NDNPH_FACE_LP_RELIABILITY_HPP
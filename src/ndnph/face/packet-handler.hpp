@@ -78,10 +78,28 @@ protected:
     lp::PitToken pitToken;
   };
 
+  /**
+   * @brief Set CongestionMark of PacketInfo.
+   *
+   * A queue or forwarder may use this to signal congestion to downstream consumers.
+   */
+  class WithCongestionMark {
+  public:
+    explicit WithCongestionMark(uint8_t congestionMark = 1)
+      : congestionMark(congestionMark) {}
+
+    void operator()(PacketInfo& pi) const {
+      pi.congestionMark = congestionMark;
+    }
+
+  public:
+    uint8_t congestionMark = 0;
+  };
+
   /**
    * @brief Synchronously transmit a packet.
    * @tparam Packet Interest, Data, their signed variants, or Nack.
-   * @tparam PacketInfoModifier WithEndpointId or WithPitToken
+   * @tparam PacketInfoModifier WithEndpointId, WithPitToken, or WithCongestionMark
    */
   template<typename Packet, typename... PacketInfoModifier>
   bool send(Region& region, const Packet& packet, const PacketInfoModifier&... pim) {
@@ -114,11 +132,17 @@ protected:
    *
    * This is most useful in processInterest, replying a Data or Nack carrying the PIT token of
    * current Interest to the endpointId of current Interest.
+   * CongestionMark of current packet is not copied to the reply.
    */
   template<typename... Arg>
   bool reply(Arg&&... arg) {
     const PacketInfo* pi = getCurrentPacketInfo();
-    return pi != nullptr && send(std::forward<Arg>(arg)..., *pi);
+    if (pi == nullptr) {
+      return false;
+    }
+    PacketInfo replyPi = *pi;
+    replyPi.congestionMark = 0;
+    return send(std::forward<Arg>(arg)..., replyPi);
   }
 
   /** @brief Helper to keep track an outgoing pending Interest. */
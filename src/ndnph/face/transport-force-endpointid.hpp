@@ -23,6 +23,10 @@ private:
     return inner.send(pkt, pktLen, m_endpointId);
   }
 
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t) final {
+    return inner.sendv(iov, iovcnt, m_endpointId);
+  }
+
 private:
   uint64_t m_endpointId;
 };
@@ -20,6 +20,19 @@ struct RxQueueItem {
 
 /** @brief Mixin of RX queue in Transport. */
 class RxQueueMixin : public virtual Transport {
+public:
+  /**
+   * @brief Enable CongestionMark on received packets.
+   * @param threshold RX queue length threshold; zero disables marking.
+   *
+   * When a single @c loop() invocation delivers more than @p threshold packets, the excess
+   * packets have been queued behind at least @p threshold packets, and they are delivered with
+   * a CongestionMark.
+   */
+  void setRxCongestionThreshold(size_t threshold) {
+    m_congestionThreshold = threshold;
+  }
+
 protected:
   /**
    * @brief Allocate receive buffers during initialization.
@@ -111,19 +124,21 @@ protected:
    * This should be called in `loop()`.
    */
   void loopRxQueue() {
-    while (true) {
+    for (size_t nDelivered = 0;; ++nDelivered) {
       RxQueueItem item;
       bool ok = false;
       std::tie(item, ok) = m_rxQ.pop();
       if (!ok) {
         break;
       }
-      invokeRxCallback(item.pkt, item.pktLen, item.endpointId);
+      bool isCongested = m_congestionThreshold > 0 && nDelivered >= m_congestionThreshold;
+      invokeRxCallback(item.pkt, item.pktLen, item.endpointId, isCongested);
       m_allocQ.push(item);
     }
   }
 
 private:
+  size_t m_congestionThreshold = 0;
   port::SafeQueue<RxQueueItem, NDNPH_TRANSPORT_RXQUEUELEN> m_allocQ;
   port::SafeQueue<RxQueueItem, NDNPH_TRANSPORT_RXQUEUELEN> m_rxQ;
 };
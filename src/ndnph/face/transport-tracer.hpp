@@ -21,9 +21,14 @@ private:
     NDNPH_LOG_LINE("%s", "%c len=%zu", category, direction, pktLen);
   }
 
+  virtual void logv(char direction, const IoVec* iov, size_t iovcnt, uint64_t endpointId) {
+    (void)endpointId;
+    NDNPH_LOG_LINE("%s", "%c len=%zu", category, direction, iovLength(iov, iovcnt));
+  }
+
   void handleRx(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) override {
     log('>', pkt, pktLen, endpointId);
-    invokeRxCallback(pkt, pktLen, endpointId);
+    invokeRxCallback(pkt, pktLen, endpointId, inner.getRxCongestionMark());
   }
 
   bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) override {
@@ -31,6 +36,11 @@ private:
     return inner.send(pkt, pktLen, endpointId);
   }
 
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId) override {
+    logv('<', iov, iovcnt, endpointId);
+    return inner.sendv(iov, iovcnt, endpointId);
+  }
+
 protected:
   const char* category;
 };
@@ -29,15 +29,79 @@ public:
     m_rxCtx = ctx;
   }
 
+  /**
+   * @brief Retrieve CongestionMark assigned by the transport to the packet being received.
+   *
+   * This is meaningful only during the incoming packet callback.
+   */
+  uint8_t getRxCongestionMark() const {
+    return m_rxCongestionMark;
+  }
+
   /** @brief Synchronously transmit a packet. */
   bool send(const uint8_t* pkt, size_t pktLen, uint64_t endpointId = 0) {
     return doSend(pkt, pktLen, endpointId);
   }
 
+  /** @brief Scatter-gather buffer element. */
+  struct IoVec {
+    const uint8_t* base;
+    size_t len;
+  };
+
+  /**
+   * @brief Determine whether @c sendv can transmit gathered buffers without copying.
+   *
+   * If this returns false, @c sendv copies into a heap-allocated linear buffer, so that callers
+   * on the transmit path should encode into a linear buffer and invoke @c send instead.
+   */
+  bool canSendv() const {
+    return doCanSendv();
+  }
+
+  /** @brief Synchronously transmit a packet gathered from @p iovcnt buffers. */
+  bool sendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId = 0) {
+    return doSendv(iov, iovcnt, endpointId);
+  }
+
 protected:
-  /** @brief Invoke incoming packet callback for a received packet. */
-  void invokeRxCallback(const uint8_t* pkt, size_t pktLen, uint64_t endpointId = 0) {
+  /**
+   * @brief Invoke incoming packet callback for a received packet.
+   * @param congestionMark nonzero if the transport has experienced congestion, such as a long
+   *                       queue, while receiving this packet.
+   */
+  void invokeRxCallback(const uint8_t* pkt, size_t pktLen, uint64_t endpointId = 0,
+                        uint8_t congestionMark = 0) {
+    m_rxCongestionMark = congestionMark;
     m_rxCb(m_rxCtx, pkt, pktLen, endpointId);
+    m_rxCongestionMark = 0;
+  }
+
+  /** @brief Total length of gathered buffers. */
+  static size_t iovLength(const IoVec* iov, size_t iovcnt) {
+    size_t len = 0;
+    for (size_t i = 0; i < iovcnt; ++i) {
+      len += iov[i].len;
+    }
+    return len;
+  }
+
+  /** @brief Copy gathered buffers into @p dst . */
+  static void iovGather(const IoVec* iov, size_t iovcnt, uint8_t* dst) {
+    for (size_t i = 0; i < iovcnt; ++i) {
+      dst = std::copy_n(iov[i].base, iov[i].len, dst);
+    }
+  }
+
+  /** @brief Transmit gathered buffers by copying them into a linear buffer. */
+  bool sendvByCopy(const IoVec* iov, size_t iovcnt, uint64_t endpointId) {
+    if (iovcnt == 1) {
+      return doSend(iov[0].base, iov[0].len, endpointId);
+    }
+    size_t pktLen = iovLength(iov, iovcnt);
+    std::unique_ptr<uint8_t[]> pkt(new uint8_t[pktLen]);
+    iovGather(iov, iovcnt, pkt.get());
+    return doSend(pkt.get(), pktLen, endpointId);
   }
 
 private:
@@ -47,9 +111,24 @@ private:
 
   virtual bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) = 0;
 
+  /** @brief Override to return true if @c doSendv is overridden to avoid copying. */
+  virtual bool doCanSendv() const {
+    return false;
+  }
+
+  /**
+   * @brief Override to transmit gathered buffers without copying.
+   *
+   * The default implementation copies into a linear buffer and invokes @c doSend .
+   */
+  virtual bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId) {
+    return sendvByCopy(iov, iovcnt, endpointId);
+  }
+
 private:
   RxCallback m_rxCb = nullptr;
   void* m_rxCtx = nullptr;
+  uint8_t m_rxCongestionMark = 0;
 };
 
 /**
@@ -71,7 +150,7 @@ private:
   }
 
   virtual void handleRx(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) {
-    invokeRxCallback(pkt, pktLen, endpointId);
+    invokeRxCallback(pkt, pktLen, endpointId, inner.getRxCongestionMark());
   }
 
   bool doIsUp() const override {
@@ -86,6 +165,14 @@ private:
     return inner.send(pkt, pktLen, endpointId);
   }
 
+  bool doCanSendv() const override {
+    return inner.canSendv();
+  }
+
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId) override {
+    return inner.sendv(iov, iovcnt, endpointId);
+  }
+
 protected:
   Transport& inner;
 };
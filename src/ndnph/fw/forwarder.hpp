@@ -0,0 +1,671 @@
+#ifndef NDNPH_FW_FORWARDER_HPP
+#define NDNPH_FW_FORWARDER_HPP
+
+#include "../face/packet-handler.hpp"
+
+namespace ndnph {
+namespace fw {
+namespace detail {
+
+/** @brief Bitmask of face IDs. */
+using FaceMask = uint32_t;
+
+/**
+ * @brief Forwarding Information Base implemented as a name trie.
+ * @tparam capacity maximum number of trie nodes, including the root node.
+ *
+ * Each node stores one name component and the set of nexthop faces. Nodes are never freed;
+ * removing the last nexthop of a route leaves an empty node that can be reused by a later route.
+ */
+template<int capacity>
+class Fib {
+public:
+  /**
+   * @brief Constructor.
+   * @param regionCap size of region for storing name components.
+   */
+  explicit Fib(size_t regionCap)
+    : m_region(regionCap) {}
+
+  /** @brief Add a nexthop to a route, creating the route if necessary. */
+  bool insert(const Name& prefix, int face) {
+    int node = 0;
+    for (const auto& comp : prefix) {
+      int child = findChild(node, comp);
+      if (child < 0) {
+        child = makeChild(node, comp);
+        if (child < 0) {
+          return false;
+        }
+      }
+      node = child;
+    }
+    m_nodes[node].nexthops |= FaceMask(1) << face;
+    return true;
+  }
+
+  /** @brief Remove a nexthop from a route. */
+  bool erase(const Name& prefix, int face) {
+    int node = 0;
+    for (const auto& comp : prefix) {
+      node = findChild(node, comp);
+      if (node < 0) {
+        return false;
+      }
+    }
+    FaceMask bit = FaceMask(1) << face;
+    bool found = (m_nodes[node].nexthops & bit) != 0;
+    m_nodes[node].nexthops &= ~bit;
+    return found;
+  }
+
+  /** @brief Remove a face from every route. */
+  void eraseFace(int face) {
+    for (int i = 0; i < m_size; ++i) {
+      m_nodes[i].nexthops &= ~(FaceMask(1) << face);
+    }
+  }
+
+  /** @brief Perform longest prefix match. */
+  FaceMask lpm(const Name& name) const {
+    int node = 0;
+    FaceMask nexthops = m_nodes[0].nexthops;
+    for (const auto& comp : name) {
+      node = findChild(node, comp);
+      if (node < 0) {
+        break;
+      }
+      if (m_nodes[node].nexthops != 0) {
+        nexthops = m_nodes[node].nexthops;
+      }
+    }
+    return nexthops;
+  }
+
+private:
+  int findChild(int parent, const Component& comp) const {
+    for (int child = m_nodes[parent].child; child >= 0; child = m_nodes[child].sibling) {
+      if (m_nodes[child].comp == comp) {
+        return child;
+      }
+    }
+    return -1;
+  }
+
+  int makeChild(int parent, const Component& comp) {
+    if (m_size >= capacity) {
+      return -1;
+    }
+    Component copy(m_region, comp.type(), comp.length(), comp.value());
+    if (!copy) {
+      return -1;
+    }
+    int child = m_size++;
+    Node& node = m_nodes[child];
+    node.comp = copy;
+    node.sibling = m_nodes[parent].child;
+    m_nodes[parent].child = child;
+    return child;
+  }
+
+private:
+  struct Node {
+    Component comp;
+    int16_t child = -1;
+    int16_t sibling = -1;
+    FaceMask nexthops = 0;
+  };
+
+  DynamicRegion m_region;
+  Node m_nodes[capacity];
+  int m_size = 1;
+
+  static_assert(capacity >= 1 && capacity <= std::numeric_limits<int16_t>::max(), "");
+};
+
+/**
+ * @brief Pending Interest Table implemented as a chained hash table.
+ * @tparam capacity maximum number of PIT entries.
+ * @tparam maxFaces maximum number of faces.
+ * @tparam nameCap maximum Name TLV-VALUE length.
+ *
+ * Entries are identified by Name, CanBePrefix, and MustBeFresh. Each entry has a 4-octet PIT
+ * token that encodes its index and a generation number, so that returning Data and Nack can find
+ * the entry without a hash lookup.
+ */
+template<int capacity, int maxFaces, size_t nameCap>
+class Pit {
+public:
+  /** @brief Downstream record. */
+  struct InRecord {
+    port::Clock::Time expire;
+    uint64_t endpointId = 0;
+    lp::PitToken pitToken;
+    uint32_t nonce = 0;
+    bool valid = false;
+  };
+
+  struct Entry {
+    /** @brief Reconstruct the Interest name. */
+    Name getName() const {
+      return Name(name, nameLength);
+    }
+
+    port::Clock::Time expire;
+    InRecord in[maxFaces];
+    /** @brief Faces where the Interest has been forwarded. */
+    FaceMask outFaces = 0;
+    /** @brief Faces that have returned Nack. */
+    FaceMask nackFaces = 0;
+    /** @brief Nonce of the last forwarded Interest. */
+    uint32_t outNonce = 0;
+    uint32_t hash = 0;
+    int16_t next = -1;
+    uint16_t generation = 0;
+    uint16_t nameLength = 0;
+    bool used = false;
+    bool canBePrefix = false;
+    bool mustBeFresh = false;
+    uint8_t name[nameCap];
+  };
+
+  explicit Pit() {
+    std::fill_n(m_buckets, NBuckets, -1);
+    for (int i = 0; i < capacity; ++i) {
+      m_entries[i].next = i + 1 < capacity ? i + 1 : -1;
+    }
+  }
+
+  Entry& operator[](int i) {
+    return m_entries[i];
+  }
+
+  /** @brief Find entry by Interest fields. */
+  int find(const Interest& interest) const {
+    uint32_t h = hashInterest(interest);
+    const Name& name = interest.getName();
+    for (int i = m_buckets[h % NBuckets]; i >= 0; i = m_entries[i].next) {
+      const Entry& entry = m_entries[i];
+      if (entry.hash == h && entry.canBePrefix == interest.getCanBePrefix() &&
+          entry.mustBeFresh == interest.getMustBeFresh() && entry.nameLength == name.length() &&
+          std::equal(name.value(), name.value() + name.length(), entry.name)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Insert entry for Interest.
+   * @return entry index, or -1 if PIT is full or name is too long.
+   */
+  int insert(const Interest& interest) {
+    const Name& name = interest.getName();
+    if (m_free < 0 || name.length() > nameCap) {
+      return -1;
+    }
+    int i = m_free;
+    Entry& entry = m_entries[i];
+    m_free = entry.next;
+
+    uint16_t generation = entry.generation + 1;
+    entry = Entry();
+    entry.generation = generation;
+    entry.used = true;
+    entry.hash = hashInterest(interest);
+    entry.canBePrefix = interest.getCanBePrefix();
+    entry.mustBeFresh = interest.getMustBeFresh();
+    entry.nameLength = name.length();
+    std::copy_n(name.value(), name.length(), entry.name);
+
+    int16_t& head = m_buckets[entry.hash % NBuckets];
+    entry.next = head;
+    head = i;
+    ++m_size;
+    return i;
+  }
+
+  /** @brief Erase entry. */
+  void erase(int i) {
+    Entry& entry = m_entries[i];
+    for (int16_t* cur = &m_buckets[entry.hash % NBuckets]; *cur >= 0;
+         cur = &m_entries[*cur].next) {
+      if (*cur == i) {
+        *cur = entry.next;
+        break;
+      }
+    }
+    entry.used = false;
+    entry.next = m_free;
+    m_free = i;
+    --m_size;
+  }
+
+  /**
+   * @brief Remove a face from every entry.
+   *
+   * Entries left without a downstream are erased.
+   */
+  void eraseFace(int face) {
+    FaceMask bit = FaceMask(1) << face;
+    for (int i = 0; i < capacity; ++i) {
+      Entry& entry = m_entries[i];
+      if (!entry.used) {
+        continue;
+      }
+      entry.in[face].valid = false;
+      entry.outFaces &= ~bit;
+      entry.nackFaces &= ~bit;
+      bool hasDownstream =
+        std::any_of(entry.in, entry.in + maxFaces, [](const InRecord& in) { return in.valid; });
+      if (!hasDownstream) {
+        erase(i);
+      }
+    }
+  }
+
+  /** @brief Determine PIT token of an entry. */
+  lp::PitToken getPitToken(int i) const {
+    return lp::PitToken::from4((static_cast<uint32_t>(m_entries[i].generation) << 16) | i);
+  }
+
+  /**
+   * @brief Find entry by PIT token.
+   * @return entry index, or -1 if not found.
+   */
+  int findPitToken(const lp::PitToken& token) const {
+    if (token.length() != 4) {
+      return -1;
+    }
+    uint32_t v = token.to4();
+    int i = v & 0xFFFF;
+    if (i >= capacity || !m_entries[i].used || m_entries[i].generation != (v >> 16)) {
+      return -1;
+    }
+    return i;
+  }
+
+  int size() const {
+    return m_size;
+  }
+
+private:
+  static uint32_t hashInterest(const Interest& interest) {
+    uint8_t flags = (interest.getCanBePrefix() ? 0x01 : 0x00) |
+                    (interest.getMustBeFresh() ? 0x02 : 0x00);
+    return ndnph::detail::fnv1a(&flags, 1, interest.getName().getPrefixHash());
+  }
+
+private:
+  static constexpr int NBuckets = capacity * 2;
+  Entry m_entries[capacity];
+  int16_t m_buckets[NBuckets];
+  int m_free = 0;
+  int m_size = 0;
+
+  static_assert(capacity >= 1 && capacity <= 0xFFFF / 2, "");
+};
+
+} // namespace detail
+
+/**
+ * @brief In-process forwarder among multiple faces.
+ * @tparam maxFaces maximum number of faces, up to 32.
+ * @tparam fibCap maximum number of FIB trie nodes.
+ * @tparam pitCap maximum number of PIT entries.
+ * @tparam nameCap maximum Interest Name TLV-VALUE length.
+ *
+ * Interests are forwarded to every FIB nexthop except the incoming face. Interests with the same
+ * Name, CanBePrefix, and MustBeFresh are aggregated into one PIT entry. An Interest whose Nonce
+ * matches a pending Interest from another face is considered a loop and rejected with a Nack.
+ * Outgoing Interests carry a PIT token that identifies the PIT entry, so that returning Data and
+ * Nack can be matched without a table lookup. Downstream PIT tokens and endpoint IDs are saved
+ * and restored on the returning packets.
+ */
+template<int maxFaces = 4, int fibCap = 32, int pitCap = 32, size_t nameCap = 256>
+class BasicForwarder {
+public:
+  /**
+   * @brief Constructor.
+   * @param fibRegionCap size of region for storing FIB name components.
+   */
+  explicit BasicForwarder(size_t fibRegionCap = 1024)
+    : m_fib(fibRegionCap) {}
+
+  /**
+   * @brief Add a face.
+   * @param face the face, which must be kept alive while the forwarder exists.
+   * @param prio packet handler priority on the face.
+   * @return face ID, or -1 upon failure.
+   *
+   * Packets not accepted by higher priority handlers on the face are processed by the forwarder.
+   */
+  int addFace(Face& face, int8_t prio = 0) {
+    for (int id = 0; id < maxFaces; ++id) {
+      if (m_faces[id] == nullptr) {
+        m_faces[id].reset(new FaceHandler(*this, id));
+        if (!face.addHandler(*m_faces[id], prio)) {
+          m_faces[id].reset();
+          return -1;
+        }
+        return id;
+      }
+    }
+    return -1;
+  }
+
+  /** @brief Remove a face, its routes, and its PIT records. */
+  bool removeFace(int id) {
+    if (!isValidFace(id)) {
+      return false;
+    }
+    m_fib.eraseFace(id);
+    m_pit.eraseFace(id);
+    m_faces[id].reset();
+    return true;
+  }
+
+  /** @brief Add a route. */
+  bool addRoute(const Name& prefix, int face) {
+    return isValidFace(face) && m_fib.insert(prefix, face);
+  }
+
+  /** @brief Remove a route. */
+  bool removeRoute(const Name& prefix, int face) {
+    return isValidFace(face) && m_fib.erase(prefix, face);
+  }
+
+  /**
+   * @brief Process periodical events.
+   *
+   * This invokes @c Face::loop() on every face, and then purges expired PIT entries.
+   */
+  void loop() {
+    for (auto& face : m_faces) {
+      if (face != nullptr) {
+        face->getFace()->loop();
+      }
+    }
+
+    auto now = port::Clock::now();
+    for (int i = 0; i < pitCap; ++i) {
+      auto& entry = m_pit[i];
+      if (entry.used && port::Clock::isBefore(entry.expire, now)) {
+        m_pit.erase(i);
+        ++m_cnt.nPitExpired;
+      }
+    }
+  }
+
+  struct Counters {
+    uint32_t nInInterests = 0;
+    uint32_t nInData = 0;
+    uint32_t nInNacks = 0;
+    uint32_t nOutInterests = 0;
+    uint32_t nOutData = 0;
+    uint32_t nOutNacks = 0;
+    uint32_t nAggregated = 0;
+    uint32_t nDuplicateNonce = 0;
+    uint32_t nNoRoute = 0;
+    uint32_t nPitFull = 0;
+    uint32_t nPitExpired = 0;
+    uint32_t nUnsolicited = 0;
+  };
+
+  Counters readCounters() const {
+    return m_cnt;
+  }
+
+  /** @brief Return number of PIT entries. */
+  int countPitEntries() const {
+    return m_pit.size();
+  }
+
+private:
+  using PacketInfo = Face::PacketInfo;
+  using FaceMask = detail::FaceMask;
+  using Pit = detail::Pit<pitCap, maxFaces, nameCap>;
+  using PitEntry = typename Pit::Entry;
+
+  class FaceHandler : public PacketHandler {
+  public:
+    explicit FaceHandler(BasicForwarder& fw, int id)
+      : m_fw(fw)
+      , m_id(id) {}
+
+    using PacketHandler::getFace;
+
+    template<typename Packet>
+    bool transmit(Region& region, const Packet& packet, PacketInfo pi) {
+      return send(region, packet, pi);
+    }
+
+  private:
+    bool processInterest(Interest interest) final {
+      return m_fw.processInterest(m_id, interest, *getCurrentPacketInfo());
+    }
+
+    bool processData(Data data) final {
+      return m_fw.processData(m_id, data, *getCurrentPacketInfo());
+    }
+
+    bool processNack(Nack nack) final {
+      return m_fw.processNack(m_id, nack, *getCurrentPacketInfo());
+    }
+
+  private:
+    BasicForwarder& m_fw;
+    int m_id;
+  };
+
+  bool isValidFace(int id) const {
+    return id >= 0 && id < maxFaces && m_faces[id] != nullptr;
+  }
+
+  bool processInterest(int face, Interest interest, const PacketInfo& pi) {
+    ++m_cnt.nInInterests;
+    uint8_t hopLimit = interest.getHopLimit();
+    if (hopLimit == 0) {
+      return true;
+    }
+    if (interest.hasHopLimit()) {
+      interest.setHopLimit(hopLimit - 1);
+    }
+
+    uint32_t nonce = interest.getNonce();
+    auto now = port::Clock::now();
+    bool isForwarding = true;
+    bool isNew = false;
+    int i = m_pit.find(interest);
+    if (i >= 0) {
+      PitEntry& entry = m_pit[i];
+      if (entry.in[face].valid && entry.in[face].nonce == nonce) {
+        return true; // duplicate delivery on the same face
+      }
+      if (isDuplicateNonce(entry, face, nonce)) {
+        ++m_cnt.nDuplicateNonce;
+        replyNack(face, interest, pi, NackReason::Duplicate);
+        return true;
+      }
+      // aggregate unless this is a retransmission from a face that already has a pending Interest
+      isForwarding = entry.in[face].valid || entry.outFaces == 0;
+      if (!isForwarding) {
+        ++m_cnt.nAggregated;
+      }
+    } else {
+      i = m_pit.insert(interest);
+      if (i < 0) {
+        ++m_cnt.nPitFull;
+        replyNack(face, interest, pi, NackReason::Congestion);
+        return true;
+      }
+      isNew = true;
+    }
+
+    PitEntry& entry = m_pit[i];
+    auto& in = entry.in[face];
+    in.valid = true;
+    in.nonce = nonce;
+    in.pitToken = pi.pitToken;
+    in.endpointId = pi.endpointId;
+    in.expire = port::Clock::add(now, interest.getLifetime());
+    if (isNew || port::Clock::isBefore(entry.expire, in.expire)) {
+      entry.expire = in.expire;
+    }
+
+    if (isForwarding) {
+      forwardInterest(i, face, interest, pi);
+    }
+    return true;
+  }
+
+  static bool isDuplicateNonce(const PitEntry& entry, int face, uint32_t nonce) {
+    for (int f = 0; f < maxFaces; ++f) {
+      if (f != face && entry.in[f].valid && entry.in[f].nonce == nonce) {
+        return true;
+      }
+    }
+    return (entry.outFaces & (FaceMask(1) << face)) != 0 && entry.outNonce == nonce;
+  }
+
+  void forwardInterest(int i, int face, Interest interest, const PacketInfo& pi) {
+    PitEntry& entry = m_pit[i];
+    FaceMask nexthops = m_fib.lpm(interest.getName()) & ~(FaceMask(1) << face);
+    if (nexthops == 0) {
+      ++m_cnt.nNoRoute;
+      entry.in[face].valid = false;
+      if (entry.outFaces == 0) {
+        m_pit.erase(i);
+      }
+      replyNack(face, interest, pi, NackReason::NoRoute);
+      return;
+    }
+
+    PacketInfo outPi;
+    outPi.pitToken = m_pit.getPitToken(i);
+    outPi.congestionMark = pi.congestionMark;
+    for (int f = 0; f < maxFaces; ++f) {
+      if ((nexthops & (FaceMask(1) << f)) == 0 || m_faces[f] == nullptr) {
+        continue;
+      }
+      if (m_faces[f]->transmit(regionOf(interest), interest.forward(), outPi)) {
+        ++m_cnt.nOutInterests;
+      }
+    }
+    entry.outFaces |= nexthops;
+    entry.nackFaces &= ~nexthops;
+    entry.outNonce = interest.getNonce();
+  }
+
+  bool processData(int face, Data data, const PacketInfo& pi) {
+    ++m_cnt.nInData;
+    bool isSatisfied = false;
+    int i = m_pit.findPitToken(pi.pitToken);
+    if (i >= 0) {
+      isSatisfied = satisfy(i, face, data, pi.congestionMark);
+    } else {
+      for (i = 0; i < pitCap; ++i) {
+        isSatisfied = (m_pit[i].used && satisfy(i, face, data, pi.congestionMark)) || isSatisfied;
+      }
+    }
+    if (!isSatisfied) {
+      ++m_cnt.nUnsolicited;
+    }
+    return true;
+  }
+
+  bool satisfy(int i, int face, Data data, uint8_t congestionMark) {
+    PitEntry& entry = m_pit[i];
+    if ((entry.outFaces & (FaceMask(1) << face)) == 0) {
+      return false;
+    }
+
+    StaticRegion<256> region;
+    Interest interest = makeInterest(region, entry);
+    if (!interest || !data.canSatisfy(interest)) {
+      return false;
+    }
+
+    auto now = port::Clock::now();
+    for (int f = 0; f < maxFaces; ++f) {
+      const auto& in = entry.in[f];
+      if (!in.valid || port::Clock::isBefore(in.expire, now) || m_faces[f] == nullptr) {
+        continue;
+      }
+      PacketInfo pi;
+      pi.pitToken = in.pitToken;
+      pi.endpointId = in.endpointId;
+      pi.congestionMark = congestionMark;
+      if (m_faces[f]->transmit(regionOf(data), data, pi)) {
+        ++m_cnt.nOutData;
+      }
+    }
+    m_pit.erase(i);
+    return true;
+  }
+
+  bool processNack(int face, Nack nack, const PacketInfo& pi) {
+    ++m_cnt.nInNacks;
+    int i = m_pit.findPitToken(pi.pitToken);
+    if (i < 0) {
+      return true;
+    }
+    PitEntry& entry = m_pit[i];
+    FaceMask bit = FaceMask(1) << face;
+    if ((entry.outFaces & bit) == 0 || nack.getInterest().getNonce() != entry.outNonce) {
+      return true;
+    }
+    entry.nackFaces |= bit;
+    if (entry.nackFaces != entry.outFaces) {
+      return true;
+    }
+
+    StaticRegion<256> region;
+    Interest interest = makeInterest(region, entry);
+    for (int f = 0; f < maxFaces; ++f) {
+      const auto& in = entry.in[f];
+      if (!in.valid || !interest) {
+        continue;
+      }
+      PacketInfo downPi;
+      downPi.pitToken = in.pitToken;
+      downPi.endpointId = in.endpointId;
+      interest.setNonce(in.nonce);
+      replyNack(f, interest, downPi, nack.getReason());
+    }
+    m_pit.erase(i);
+    return true;
+  }
+
+  static Interest makeInterest(Region& region, const PitEntry& entry) {
+    Interest interest = region.create<Interest>();
+    if (interest) {
+      interest.setName(entry.getName());
+      interest.setCanBePrefix(entry.canBePrefix);
+      interest.setMustBeFresh(entry.mustBeFresh);
+    }
+    return interest;
+  }
+
+  void replyNack(int face, Interest interest, const PacketInfo& pi, NackReason reason) {
+    Nack nack = Nack::create(interest, reason);
+    if (nack && m_faces[face] != nullptr && m_faces[face]->transmit(regionOf(nack), nack, pi)) {
+      ++m_cnt.nOutNacks;
+    }
+  }
+
+private:
+  std::unique_ptr<FaceHandler> m_faces[maxFaces];
+  detail::Fib<fibCap> m_fib;
+  Pit m_pit;
+  Counters m_cnt;
+
+  static_assert(maxFaces >= 1 && maxFaces <= 32, "");
+};
+
+using Forwarder = BasicForwarder<>;
+
+} // namespace fw
+} // namespace ndnph
+
+#endif // NDNPH_FW_FORWARDER_HPP
@@ -24,7 +24,19 @@ public:
   using PacketStore::PacketStore;
 
   Data get(const char* id, Region& region) {
-    Data data = PacketStore::get(id, region);
+    return checkCertificate(PacketStore::get(id, region));
+  }
+
+  /**
+   * @brief Retrieve a certificate without copying its encoding.
+   * @sa PacketStore::getMapped
+   */
+  Data getMapped(const char* id, Region& region) {
+    return checkCertificate(PacketStore::getMapped(id, region));
+  }
+
+private:
+  static Data checkCertificate(Data data) {
     if (!data || !certificate::isCertificate(data)) {
       return Data();
     }
@@ -15,6 +15,8 @@ enum {
   Nack = 0x0320,
   NackReason = 0x0321,
   CongestionMark = 0x0340,
+  Ack = 0x0344,
+  TxSequence = 0x0348,
 
   Name = 0x07,
   GenericNameComponent = 0x08,
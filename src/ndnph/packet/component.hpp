@@ -7,6 +7,87 @@
 #include "an.hpp"
 
 namespace ndnph {
+namespace detail {
+
+/** @brief Component URI split into TLV-TYPE and TLV-VALUE. */
+struct ComponentUri {
+  const char* value = nullptr; ///< start of TLV-VALUE in URI
+  const char* end = nullptr;   ///< end of URI
+  size_t length = 0;           ///< TLV-LENGTH after unescaping
+  uint16_t type = 0;           ///< TLV-TYPE, or 0 if URI is invalid
+};
+
+/** @brief Scan a component URI to determine its TLV-TYPE and exact TLV-LENGTH. */
+inline ComponentUri
+scanComponentUri(const char* uri, const char* uriEnd) {
+  ComponentUri scan;
+  scan.value = uri;
+  scan.end = uriEnd;
+  scan.type = TT::GenericNameComponent;
+
+  uint32_t type = 0;
+  const char* pos = uri;
+  for (; pos != uriEnd && *pos >= '0' && *pos <= '9'; ++pos) {
+    type = std::min<uint32_t>(type * 10 + (*pos - '0'), 0x10000);
+  }
+  if (pos != uri && pos != uriEnd && *pos == '=') {
+    scan.type = type > 0xFFFF ? 0 : type;
+    scan.value = pos + 1;
+  }
+
+  bool hasNonPeriod = false;
+  bool hasEqual = false;
+  for (pos = scan.value; pos != uriEnd; ++scan.length) {
+    hasNonPeriod = hasNonPeriod || *pos != '.';
+    hasEqual = hasEqual || *pos == '=';
+    pos += *pos == '%' && uriEnd - pos >= 3 ? 3 : 1;
+  }
+  if (hasEqual && scan.value == uri) { // '=' without a valid TLV-TYPE prefix
+    scan.type = 0;
+  }
+  if (!hasNonPeriod && scan.length >= 3) {
+    scan.value += 3;
+    scan.length -= 3;
+  }
+  return scan;
+}
+
+/** @brief Parse a hexadecimal digit, or return -1 if it is not a hexadecimal digit. */
+inline int
+parseHexDigit(char ch) {
+  return ch >= '0' && ch <= '9'   ? ch - '0'
+         : ch >= 'A' && ch <= 'F' ? ch - 'A' + 10
+         : ch >= 'a' && ch <= 'f' ? ch - 'a' + 10
+                                  : -1;
+}
+
+/** @brief Write unescaped TLV-VALUE of a scanned component URI; @c scan.length octets. */
+inline void
+writeComponentUriValue(uint8_t* buf, const ComponentUri& scan) {
+  for (const char* pos = scan.value; pos != scan.end; ++buf) {
+    if (*pos == '%' && scan.end - pos >= 3) {
+      int hi = parseHexDigit(pos[1]);
+      int lo = parseHexDigit(pos[2]);
+      *buf = hi < 0 ? 0 : lo < 0 ? hi : (hi << 4) | lo;
+      pos += 3;
+    } else {
+      *buf = *pos++;
+    }
+  }
+}
+
+/** @brief Determine whether @p ch is an unreserved character in URI. */
+inline bool
+isUriUnreserved(uint8_t ch) {
+  // bit (ch % 8) of octet (ch / 8) is set for ALPHA, DIGIT, '-', '.', '_', '~'
+  static const uint8_t table[16] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0xFF, 0x03,
+    0xFE, 0xFF, 0xFF, 0x87, 0xFE, 0xFF, 0xFF, 0x47,
+  };
+  return ch < 0x80 && ((table[ch >> 3] >> (ch & 0x07)) & 0x01) != 0;
+}
+
+} // namespace detail
 
 /**
  * @brief Name component.
@@ -87,7 +168,7 @@ public:
 
   /**
    * @brief Parse from URI.
-   * @param region memory region; must have 8 + strlen(uri) available room.
+   * @param region memory region; must have room for the encoded component.
    * @param uri URI in canonical format; except that `8=` prefix of GenericNameComponent
    *            may be omitted.
    * @return component; it's valid if !component is false.
@@ -99,14 +180,12 @@ public:
   }
 
   static Component parse(Region& region, const char* uri, size_t uriLen) {
-    size_t bufLen = 8 + uriLen;
-    uint8_t* buf = region.alloc(bufLen);
-    if (buf == nullptr) {
+    auto scan = detail::scanComponentUri(uri, uri + uriLen);
+    if (scan.type == 0) {
       return Component();
     }
-    Component comp = parse(buf, bufLen, uri, uriLen, true);
-    region.free(buf, !comp ? bufLen : comp.m_tlv - buf);
-    return comp;
+    size_t size = computeSize(scan.type, scan.length);
+    return parse(region.alloc(size), size, scan);
   }
 
   /** @brief Parse from URI into provided buffer. */
@@ -116,21 +195,27 @@ public:
 
   static Component parse(uint8_t* buf, size_t bufLen, const char* uri, size_t uriLen,
                          bool writeFromBack = false) {
-    const char* uriEnd = uri + uriLen;
-    const char* posEqual = std::find(uri, uriEnd, '=');
-    uint16_t type = TT::GenericNameComponent;
-    if (posEqual != uriEnd) {
-      type = std::strtoul(uri, nullptr, 10);
-      uri = posEqual + 1;
+    auto scan = detail::scanComponentUri(uri, uri + uriLen);
+    size_t size = computeSize(scan.type, scan.length);
+    if (writeFromBack && bufLen >= size) {
+      buf += bufLen - size;
+      bufLen = size;
     }
+    return parse(buf, bufLen, scan);
+  }
 
-    size_t valueOffset = std::min(bufLen, tlv::sizeofVarNum(type) + tlv::sizeofVarNum(uriLen));
-    uint8_t* valueBuf = buf + valueOffset; // write TLV-VALUE in place in most cases
-    ssize_t length = parseUriValue(valueBuf, bufLen - valueOffset, uri, uriEnd);
-    if (length < 0) {
+  /**
+   * @brief Construct from scanned URI into front of provided buffer.
+   * @param bufLen size of buf; if insufficient, !component will be true.
+   */
+  static Component parse(uint8_t* buf, size_t bufLen, const detail::ComponentUri& scan) {
+    size_t size = computeSize(scan.type, scan.length);
+    if (scan.type == 0 || buf == nullptr || bufLen < size) {
       return Component();
     }
-    return Component(buf, bufLen, type, length, valueBuf, writeFromBack);
+    uint8_t* valueBuf = buf + size - scan.length;
+    detail::writeComponentUriValue(valueBuf, scan);
+    return Component(buf, size, scan.type, scan.length, valueBuf);
   }
 
   /** @brief Return true if Component is valid. */
@@ -158,6 +243,10 @@ public:
     return m_value - m_tlv + m_length;
   }
 
+  size_t encodedSize() const {
+    return size();
+  }
+
   void encodeTo(Encoder& encoder) const {
     if (m_type == 0) {
       encoder.setError();
@@ -200,47 +289,49 @@ private:
     return tlv::sizeofVarNum(type) + tlv::sizeofVarNum(length) + length;
   }
 
-  static ssize_t parseUriValue(uint8_t* buf, size_t bufLen, const char* uri, const char* uriEnd) {
-    if (std::count(uri, uriEnd, '.') == uriEnd - uri && uriEnd - uri >= 3) {
-      uri += 3;
+  /**
+   * @brief Print URI in chunks.
+   * @param output function that accepts a NUL-terminated string.
+   */
+  template<typename F>
+  void printImpl(const F& output) const {
+    static const char hexDigits[] = "0123456789ABCDEF";
+    char buf[32];
+    size_t n = 0;
+    for (uint16_t type = m_type; type > 0 || n == 0; type /= 10) {
+      buf[n++] = '0' + type % 10;
     }
-
-    for (size_t j = 0; j < bufLen; ++j) {
-      if (uri == uriEnd) {
-        return j;
+    std::reverse(buf, buf + n);
+    buf[n++] = '=';
+
+    bool hasNonPeriod = false;
+    for (const uint8_t* pos = m_value; pos != m_value + m_length; ++pos) {
+      if (n + 4 > sizeof(buf)) {
+        buf[n] = '\0';
+        output(buf);
+        n = 0;
       }
-
-      if (*uri == '%' && uri + 3 <= uriEnd) {
-        char hex[] = {uri[1], uri[2], 0};
-        buf[j] = std::strtoul(hex, nullptr, 16);
-        uri += 3;
+      uint8_t ch = *pos;
+      hasNonPeriod = hasNonPeriod || ch != '.';
+      if (detail::isUriUnreserved(ch)) {
+        buf[n++] = ch;
       } else {
-        buf[j] = *uri++;
+        buf[n++] = '%';
+        buf[n++] = hexDigits[ch >> 4];
+        buf[n++] = hexDigits[ch & 0x0F];
       }
     }
-    return -1;
-  }
-
-  template<typename F>
-  void printImpl(const F& output) const {
-    char buf[7];
-    snprintf(buf, sizeof(buf), "%d=", static_cast<int>(m_type));
-    output(buf);
-    size_t nNonPeriods = 0;
-    std::for_each(m_value, m_value + m_length, [&](uint8_t ch) {
-      if (ch != 0x00 && strchr("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~",
-                               ch) != nullptr) {
-        buf[0] = ch;
-        buf[1] = 0;
-      } else {
-        snprintf(buf, sizeof(buf), "%%%02X", static_cast<int>(ch));
-      }
+    if (n + 4 > sizeof(buf)) {
+      buf[n] = '\0';
       output(buf);
-      nNonPeriods += ch != '.';
-    });
-    if (nNonPeriods == 0) {
-      output("...");
+      n = 0;
     }
+    if (!hasNonPeriod) {
+      std::copy_n("...", 3, &buf[n]);
+      n += 3;
+    }
+    buf[n] = '\0';
+    output(buf);
   }
 
 #ifdef NDNPH_PRINT_OSTREAM
@@ -17,6 +17,8 @@ struct DataSigned {
   tlv::Value sigValue;
   tlv::Value signedPortion;
   tlv::Value wholePacket;
+  bool isLazy = false;        ///< whether sigInfo is not yet decoded
+  bool hasBadSigInfo = false; ///< whether deferred decoding of sigInfo failed
 };
 
 /** @brief Fields in Data. */
@@ -39,6 +41,50 @@ public:
   bool isFinalBlock = false;
 };
 
+/**
+ * @brief Encode and sign a Data packet.
+ * @param encodeSignedPortion function to prepend Name, MetaInfo, Content, and DSigInfo.
+ */
+template<typename Fn>
+inline void
+encodeSignedData(Encoder& encoder, const PrivateKey& key, const Fn& encodeSignedPortion) {
+  const uint8_t* afterSig = encoder.begin();
+  size_t maxSigLen = key.getMaxSigLen();
+  uint8_t* sigBuf = encoder.prependRoom(maxSigLen);
+  encoder.prependTypeLength(TT::DSigValue, maxSigLen);
+  const uint8_t* afterSignedPortion = encoder.begin();
+  encodeSignedPortion(encoder);
+  if (!encoder) {
+    return;
+  }
+
+  tlv::Value signedPortion(encoder.begin(), afterSignedPortion);
+  ssize_t sigLen = key.sign({signedPortion}, sigBuf);
+  if (sigLen < 0) {
+    encoder.setError();
+    return;
+  }
+
+  encoder.resetFront(const_cast<uint8_t*>(afterSig));
+  encoder.prependTlv(
+    TT::Data,
+    [=](Encoder& encoder) {
+      uint8_t* room = encoder.prependRoom(signedPortion.size());
+      NDNPH_ASSERT(room != nullptr);
+      if (room != signedPortion.begin()) {
+        std::memmove(room, signedPortion.begin(), signedPortion.size());
+      }
+    },
+    [=](Encoder& encoder) {
+      uint8_t* room = encoder.prependRoom(sigLen);
+      NDNPH_ASSERT(room != nullptr);
+      if (room != sigBuf) {
+        std::memmove(room, sigBuf, sigLen);
+      }
+      encoder.prependTypeLength(TT::DSigValue, sigLen);
+    });
+}
+
 class SignedDataRef : public RefRegion<DataObj> {
 public:
   explicit SignedDataRef() = default;
@@ -50,51 +96,59 @@ public:
     m_sigInfo = std::move(sigInfo);
   }
 
+  /**
+   * @brief Compute encoded size.
+   * @return exact size if the key has fixed signature length, otherwise an upper bound.
+   */
+  size_t encodedSize() const {
+    if (m_key == nullptr) {
+      return 0;
+    }
+    return tlv::sizeofTlv(TT::Data, sizeofSignedPortion(obj->content.size()) +
+                                      tlv::sizeofTlv(TT::DSigValue, m_key->getMaxSigLen()));
+  }
+
   void encodeTo(Encoder& encoder) const {
     if (m_key == nullptr) {
       encoder.setError();
       return;
     }
+    encodeSignedData(encoder, *m_key, [this](Encoder& encoder) {
+      encodeSignedPortion(encoder, [this](Encoder& encoder) {
+        encoder.prependTlv(TT::Content, Encoder::OmitEmpty, obj->content);
+      });
+    });
+  }
 
-    const uint8_t* afterSig = encoder.begin();
-    size_t maxSigLen = m_key->getMaxSigLen();
-    uint8_t* sigBuf = encoder.prependRoom(maxSigLen);
-    encoder.prependTypeLength(TT::DSigValue, maxSigLen);
-    const uint8_t* afterSignedPortion = encoder.begin();
-    encodeSignedPortion(encoder);
-    if (!encoder) {
-      return;
+protected:
+  size_t sizeofSignedPortion(size_t contentSize) const {
+    size_t metaInfo = 0;
+    if (obj->contentType != DataObj::DefaultContentType) {
+      metaInfo += tlv::NniElement<>(TT::ContentType, obj->contentType).encodedSize();
     }
-
-    tlv::Value signedPortion(encoder.begin(), afterSignedPortion);
-    ssize_t sigLen = m_key->sign({signedPortion}, sigBuf);
-    if (sigLen < 0) {
-      encoder.setError();
-      return;
+    if (obj->freshnessPeriod != DataObj::DefaultFreshnessPeriod) {
+      metaInfo += tlv::NniElement<>(TT::FreshnessPeriod, obj->freshnessPeriod).encodedSize();
+    }
+    if (obj->isFinalBlock) {
+      metaInfo += tlv::sizeofTlv(TT::FinalBlock, obj->name[-1].size());
     }
 
-    encoder.resetFront(const_cast<uint8_t*>(afterSig));
-    encoder.prependTlv(
-      TT::Data,
-      [=](Encoder& encoder) {
-        uint8_t* room = encoder.prependRoom(signedPortion.size());
-        NDNPH_ASSERT(room != nullptr);
-        if (room != signedPortion.begin()) {
-          std::memmove(room, signedPortion.begin(), signedPortion.size());
-        }
-      },
-      [=](Encoder& encoder) {
-        uint8_t* room = encoder.prependRoom(sigLen);
-        NDNPH_ASSERT(room != nullptr);
-        if (room != sigBuf) {
-          std::memmove(room, sigBuf, sigLen);
-        }
-        encoder.prependTypeLength(TT::DSigValue, sigLen);
-      });
+    size_t size = obj->name.encodedSize() + m_sigInfo.encodedSize();
+    if (metaInfo > 0) {
+      size += tlv::sizeofTlv(TT::MetaInfo, metaInfo);
+    }
+    if (contentSize > 0) {
+      size += tlv::sizeofTlv(TT::Content, contentSize);
+    }
+    return size;
   }
 
-private:
-  void encodeSignedPortion(Encoder& encoder) const {
+  /**
+   * @brief Prepend Name, MetaInfo, Content, and DSigInfo.
+   * @param encodeContent function to prepend Content element.
+   */
+  template<typename ContentFn>
+  void encodeSignedPortion(Encoder& encoder, const ContentFn& encodeContent) const {
     encoder.prepend(
       obj->name,
       [this](Encoder& encoder) {
@@ -117,17 +171,138 @@ private:
             }
           });
       },
-      [this](Encoder& encoder) {
-        encoder.prependTlv(TT::Content, Encoder::OmitEmpty, obj->content);
-      },
-      m_sigInfo);
+      encodeContent, m_sigInfo);
   }
 
-private:
+protected:
   const PrivateKey* m_key = nullptr;
   DSigInfo m_sigInfo;
 };
 
+class GatheredDataRef : public SignedDataRef {
+public:
+  /** @brief Maximum number of Content chunks. */
+  using MaxChunks = std::integral_constant<size_t, 4>;
+
+  explicit GatheredDataRef() = default;
+
+  explicit GatheredDataRef(DataObj* data, const PrivateKey& key, DSigInfo sigInfo,
+                           const tlv::Value* chunks, size_t nChunks)
+    : SignedDataRef(data, key, std::move(sigInfo)) {
+    if (nChunks > MaxChunks::value) {
+      m_key = nullptr;
+      return;
+    }
+    std::copy_n(chunks, nChunks, m_chunks.begin());
+    m_nChunks = nChunks;
+    for (size_t i = 0; i < nChunks; ++i) {
+      m_contentSize += chunks[i].size();
+    }
+  }
+
+  /**
+   * @brief Compute encoded size.
+   * @return exact size if the key has fixed signature length, otherwise an upper bound.
+   */
+  size_t encodedSize() const {
+    if (m_key == nullptr) {
+      return 0;
+    }
+    return tlv::sizeofTlv(TT::Data, sizeofSignedPortion(m_contentSize) +
+                                      tlv::sizeofTlv(TT::DSigValue, m_key->getMaxSigLen()));
+  }
+
+  /** @brief Encode the packet into a linear buffer, copying Content chunks. */
+  void encodeTo(Encoder& encoder) const {
+    if (m_key == nullptr) {
+      encoder.setError();
+      return;
+    }
+    encodeSignedData(encoder, *m_key, [this](Encoder& encoder) {
+      encodeSignedPortion(encoder, [this](Encoder& encoder) {
+        encoder.prependTlv(TT::Content, Encoder::OmitEmpty, [this](Encoder& encoder) {
+          for (size_t i = m_nChunks; i > 0; --i) {
+            encoder.prepend(m_chunks[i - 1]);
+          }
+        });
+      });
+    });
+  }
+
+  /**
+   * @brief Encode everything except Content chunks.
+   * @param[out] bufs packet buffers in order; must have room for MaxChunks+2 elements.
+   * @return number of elements written to @p bufs , or 0 upon error.
+   *
+   * The packet consists of the leading part of encoder output up to Content TLV-LENGTH, the
+   * Content chunks, and the remaining part of encoder output. They may be transmitted via
+   * @c Transport::sendv without copying the Content chunks. The first buffer starts at
+   * encoder.begin(), so that further headers may be prepended.
+   */
+  size_t encodeGatherTo(Encoder& encoder, tlv::Value* bufs) const {
+    if (m_key == nullptr) {
+      encoder.setError();
+      return 0;
+    }
+
+    const uint8_t* afterSig = encoder.begin();
+    size_t maxSigLen = m_key->getMaxSigLen();
+    uint8_t* sigBuf = encoder.prependRoom(maxSigLen);
+    encoder.prependTypeLength(TT::DSigValue, maxSigLen);
+    const uint8_t* afterSigInfo = encoder.begin();
+    const uint8_t* beforeSigInfo = nullptr;
+    encodeSignedPortion(encoder, [&](Encoder& encoder) {
+      beforeSigInfo = encoder.begin();
+      if (m_contentSize > 0) {
+        encoder.prependTypeLength(TT::Content, m_contentSize);
+      }
+    });
+    if (!encoder) {
+      return 0;
+    }
+
+    tlv::Value head(encoder.begin(), beforeSigInfo);
+    tlv::Value tail(beforeSigInfo, afterSigInfo);
+    static_assert(MaxChunks::value == 4, "");
+    ssize_t sigLen =
+      m_key->sign({head, m_chunks[0], m_chunks[1], m_chunks[2], m_chunks[3], tail}, sigBuf);
+    if (sigLen < 0) {
+      encoder.setError();
+      return 0;
+    }
+
+    encoder.resetFront(const_cast<uint8_t*>(afterSig));
+    prependMoved(encoder, tlv::Value(sigBuf, sigLen));
+    encoder.prependTypeLength(TT::DSigValue, sigLen);
+    tail = prependMoved(encoder, tail);
+    head = prependMoved(encoder, head);
+    encoder.prependTypeLength(TT::Data, afterSig - head.begin() + m_contentSize);
+    if (!encoder) {
+      return 0;
+    }
+
+    bufs[0] = tlv::Value(encoder.begin(), head.end());
+    std::copy_n(m_chunks.begin(), m_nChunks, &bufs[1]);
+    bufs[1 + m_nChunks] = tlv::Value(tail.begin(), afterSig);
+    return m_nChunks + 2;
+  }
+
+private:
+  static tlv::Value prependMoved(Encoder& encoder, const tlv::Value& value) {
+    uint8_t* room = encoder.prependRoom(value.size());
+    NDNPH_ASSERT(room != nullptr);
+    if (room != value.begin()) {
+      std::memmove(room, value.begin(), value.size());
+    }
+    return tlv::Value(room, value.size());
+  }
+
+private:
+  std::array<tlv::Value, MaxChunks::value> m_chunks;
+  size_t m_nChunks = 0;
+  size_t m_contentSize = 0;
+};
+
 } // namespace detail
 
 /** @brief Data packet. */
@@ -182,7 +357,22 @@ public:
    * @pre only available on decoded packet.
    */
   const DSigInfo* getSigInfo() const {
-    return obj->sig == nullptr ? nullptr : &obj->sig->sigInfo;
+    if (obj->sig == nullptr) {
+      return nullptr;
+    }
+    if (obj->sig->isLazy) {
+      obj->sig->isLazy = false;
+      obj->sig->hasBadSigInfo = !decodeSigInfo(*obj->sig);
+    }
+    return obj->sig->hasBadSigInfo ? nullptr : &obj->sig->sigInfo;
+  }
+
+  /**
+   * @brief Compute encoded size of the original packet.
+   * @pre only available on decoded packet.
+   */
+  size_t encodedSize() const {
+    return obj->sig == nullptr ? 0 : obj->sig->wholePacket.size();
   }
 
   /**
@@ -199,28 +389,17 @@ public:
 
   /** @brief Decode packet. */
   bool decodeFrom(const Decoder::Tlv& input) {
-    obj->sig = regionOf(obj).template make<detail::DataSigned>();
-    if (obj->sig == nullptr) {
-      return false;
-    }
-    obj->sig->wholePacket = tlv::Value(input.tlv, input.size);
-    return EvDecoder::decode(
-      input, {TT::Data}, EvDecoder::def<TT::Name>(&obj->name),
-      EvDecoder::def<TT::MetaInfo>([this](const Decoder::Tlv& d) {
-        return EvDecoder::decode(d, {}, EvDecoder::defNni<TT::ContentType>(&obj->contentType),
-                                 EvDecoder::defNni<TT::FreshnessPeriod>(&obj->freshnessPeriod),
-                                 EvDecoder::def<TT::FinalBlock>([this](const Decoder::Tlv& d) {
-                                   auto comp = getName()[-1];
-                                   setIsFinalBlock(
-                                     d.length == comp.size() &&
-                                     std::equal(d.value, d.value + d.length, comp.tlv()));
-                                 }));
-      }),
-      EvDecoder::def<TT::Content>(&obj->content), EvDecoder::def<TT::DSigInfo>(&obj->sig->sigInfo),
-      EvDecoder::def<TT::DSigValue>([this, &input](const Decoder::Tlv& d) {
-        obj->sig->signedPortion = tlv::Value(input.value, d.tlv);
-        return obj->sig->sigValue.decodeFrom(d);
-      }));
+    return decodeImpl(input, false);
+  }
+
+  /**
+   * @brief Decode packet, deferring SignatureInfo.
+   *
+   * SignatureInfo is located but not parsed until first accessed via getSigInfo() or verify().
+   * If it turns out to be malformed, getSigInfo() returns nullptr and verify() fails.
+   */
+  bool decodeLazy(const Decoder::Tlv& input) {
+    return decodeImpl(input, true);
   }
 
   /**
@@ -245,6 +424,9 @@ public:
   /** @brief Result of Data::sign operation. */
   using Signed = detail::SignedDataRef;
 
+  /** @brief Result of Data::signGathered operation. */
+  using Gathered = detail::GatheredDataRef;
+
   /**
    * @brief Sign the packet with a private key.
    * @return an Encodable object. This object is valid only if Data and PrivateKey are kept alive.
@@ -255,14 +437,28 @@ public:
     return Signed(obj, key, std::move(sigInfo));
   }
 
+  /**
+   * @brief Sign the packet with Content gathered from multiple buffers.
+   * @param chunks Content chunks, at most Gathered::MaxChunks. They are referenced rather than
+   *               copied, and must remain valid until the packet is encoded.
+   * @param nChunks number of Content chunks.
+   * @return an Encodable object. Content set via setContent() is ignored.
+   * @sa Gathered::encodeGatherTo
+   */
+  Gathered signGathered(const PrivateKey& key, const tlv::Value* chunks, size_t nChunks,
+                        DSigInfo sigInfo = DSigInfo()) const {
+    return Gathered(obj, key, std::move(sigInfo), chunks, nChunks);
+  }
+
   /**
    * @brief Verify the packet with a public key.
    * @pre only available on decoded packet.
    * @return verification result.
    */
   bool verify(const PublicKey& key) const {
-    return obj->sig != nullptr && key.verify({obj->sig->signedPortion}, obj->sig->sigValue.begin(),
-                                             obj->sig->sigValue.size());
+    return getSigInfo() != nullptr && key.verify({obj->sig->signedPortion},
+                                                 obj->sig->sigValue.begin(),
+                                                 obj->sig->sigValue.size());
   }
 
   /**
@@ -334,6 +530,49 @@ public:
     return p.print(getName());
   }
 #endif
+
+private:
+  bool decodeImpl(const Decoder::Tlv& input, bool lazy) {
+    obj->sig = regionOf(obj).template make<detail::DataSigned>();
+    if (obj->sig == nullptr) {
+      return false;
+    }
+    obj->sig->wholePacket = tlv::Value(input.tlv, input.size);
+    obj->sig->isLazy = lazy;
+    return EvDecoder::decode(
+      input, {TT::Data},
+      EvDecoder::def<TT::Name>(&obj->name),
+      EvDecoder::def<TT::MetaInfo>([this](const Decoder::Tlv& d) {
+        return EvDecoder::decode(d, {}, EvDecoder::defNni<TT::ContentType>(&obj->contentType),
+                                 EvDecoder::defNni<TT::FreshnessPeriod>(&obj->freshnessPeriod),
+                                 EvDecoder::def<TT::FinalBlock>([this](const Decoder::Tlv& d) {
+                                   auto comp = getName()[-1];
+                                   setIsFinalBlock(
+                                     d.length == comp.size() &&
+                                     std::equal(d.value, d.value + d.length, comp.tlv()));
+                                 }));
+      }),
+      EvDecoder::def<TT::Content>(&obj->content),
+      EvDecoder::def<TT::DSigInfo>([this](const Decoder::Tlv& d) {
+        return obj->sig->isLazy || obj->sig->sigInfo.decodeFrom(d);
+      }),
+      EvDecoder::def<TT::DSigValue>([this, &input](const Decoder::Tlv& d) {
+        obj->sig->signedPortion = tlv::Value(input.value, d.tlv);
+        return obj->sig->sigValue.decodeFrom(d);
+      }));
+  }
+
+  /** @brief Parse SignatureInfo found in the whole packet. */
+  static bool decodeSigInfo(detail::DataSigned& sig) {
+    Decoder::Tlv input;
+    Decoder::readTlv(input, sig.wholePacket.begin(), sig.wholePacket.end());
+    for (const auto& d : input.vd()) {
+      if (d.type == TT::DSigInfo) {
+        return sig.sigInfo.decodeFrom(d);
+      }
+    }
+    return true;
+  }
 };
 
 #ifdef NDNPH_PRINT_OSTREAM
@@ -31,6 +31,7 @@ struct InterestParams {
   tlv::Value sigValue;
   tlv::Value signedParams;
   tlv::Value allParams;
+  bool isLazy = false; ///< whether fields other than allParams are not yet decoded
 };
 
 /** @brief Fields in Interest or Nack. */
@@ -40,6 +41,7 @@ public:
     : InRegion(region)
     , canBePrefix(false)
     , mustBeFresh(false)
+    , hasHopLimit(false)
     , nackReason(0) {
     port::RandomSource::generate(reinterpret_cast<uint8_t*>(&nonce), sizeof(nonce));
   }
@@ -58,6 +60,7 @@ public:
   uint8_t hopLimit = MaxHopLimit;
   bool canBePrefix : 1;
   bool mustBeFresh : 1;
+  bool hasHopLimit : 1; // HopLimit is present, even if it equals MaxHopLimit
   uint8_t nackReason : 3;
 };
 
@@ -93,9 +96,35 @@ public:
     return obj->hopLimit;
   }
 
+  /** @brief Determine whether HopLimit is present. */
+  bool hasHopLimit() const {
+    return obj->hasHopLimit;
+  }
+
 protected:
   ~InterestRefBase() = default;
 
+  /** @brief Compute encoded size of fields between Name and AppParameters. */
+  size_t sizeofMiddle() const {
+    size_t size = tlv::NniElement<tlv::NNI4>(TT::Nonce, obj->nonce).encodedSize();
+    if (obj->canBePrefix) {
+      size += tlv::sizeofTlv(TT::CanBePrefix, 0);
+    }
+    if (obj->mustBeFresh) {
+      size += tlv::sizeofTlv(TT::MustBeFresh, 0);
+    }
+    if (obj->fwHint) {
+      size += tlv::sizeofTlv(TT::ForwardingHint, obj->fwHint.encodedSize());
+    }
+    if (obj->lifetime != InterestObj::DefaultLifetime) {
+      size += tlv::NniElement<>(TT::InterestLifetime, obj->lifetime).encodedSize();
+    }
+    if (obj->hasHopLimit) {
+      size += tlv::sizeofTlv(TT::HopLimit, 1);
+    }
+    return size;
+  }
+
   void encodeMiddle(Encoder& encoder) const {
     encoder.prepend(
       [this](Encoder& encoder) {
@@ -116,7 +145,7 @@ protected:
         }
       },
       [this](Encoder& encoder) {
-        if (obj->hopLimit != InterestObj::MaxHopLimit) {
+        if (obj->hasHopLimit) {
           encoder.prependTlv(TT::HopLimit, tlv::NNI1(obj->hopLimit));
         }
       });
@@ -142,6 +171,14 @@ public:
     : InterestRefBase(interest)
     , m_appParameters(std::move(appParameters)) {}
 
+  /** @brief Compute encoded size. */
+  size_t encodedSize() const {
+    if (obj == nullptr) {
+      return 0;
+    }
+    return tlv::sizeofTlv(TT::Interest, sizeofName() + sizeofMiddle() + sizeofAppParameters());
+  }
+
   void encodeTo(Encoder& encoder) const {
     if (obj == nullptr) {
       encoder.setError();
@@ -154,6 +191,21 @@ public:
 protected:
   ~ParameterizedInterestRef() = default;
 
+  /** @brief Compute encoded size of Name with ParametersSha256DigestComponent. */
+  size_t sizeofName() const {
+    size_t length = obj->name.length() + tlv::sizeofTlv(TT::ParametersSha256DigestComponent,
+                                                        NDNPH_SHA256_LEN);
+    int posParamsDigest = findParamsDigest(obj->name);
+    if (posParamsDigest >= 0) {
+      length -= obj->name[posParamsDigest].size();
+    }
+    return tlv::sizeofTlv(TT::Name, length);
+  }
+
+  size_t sizeofAppParameters() const {
+    return tlv::sizeofTlv(TT::AppParameters, m_appParameters.size());
+  }
+
   void encodeName(Encoder& encoder, const tlv::Value& params) const {
     port::Sha256 hash;
     hash.update(params.begin(), params.size());
@@ -215,6 +267,19 @@ public:
     m_sigInfo = std::move(sigInfo);
   }
 
+  /**
+   * @brief Compute encoded size.
+   * @return exact size if the key has fixed signature length, otherwise an upper bound.
+   */
+  size_t encodedSize() const {
+    if (m_key == nullptr) {
+      return 0;
+    }
+    return tlv::sizeofTlv(TT::Interest, sizeofName() + sizeofMiddle() + sizeofAppParameters() +
+                                          m_sigInfo.encodedSize() +
+                                          tlv::sizeofTlv(TT::ISigValue, m_key->getMaxSigLen()));
+  }
+
   void encodeTo(Encoder& encoder) const {
     if (m_key == nullptr) {
       encoder.setError();
@@ -276,6 +341,31 @@ private:
   ISigInfo m_sigInfo;
 };
 
+class ForwardedInterestRef : public InterestRefBase {
+public:
+  using InterestRefBase::InterestRefBase;
+
+  /** @brief Compute encoded size. */
+  size_t encodedSize() const {
+    if (obj == nullptr) {
+      return 0;
+    }
+    size_t params = obj->params == nullptr ? 0 : obj->params->allParams.size();
+    return tlv::sizeofTlv(TT::Interest, obj->name.encodedSize() + sizeofMiddle() + params);
+  }
+
+  void encodeTo(Encoder& encoder) const {
+    if (obj == nullptr) {
+      encoder.setError();
+      return;
+    }
+
+    encoder.prependTlv(TT::Interest, obj->name,
+                       [this](Encoder& encoder) { encodeMiddle(encoder); },
+                       obj->params == nullptr ? tlv::Value() : obj->params->allParams);
+  }
+};
+
 } // namespace detail
 
 /** @brief Interest packet. */
@@ -311,6 +401,7 @@ public:
 
   void setHopLimit(uint8_t v) {
     obj->hopLimit = v;
+    obj->hasHopLimit = true;
   }
 
   /**
@@ -319,10 +410,11 @@ public:
    * @note To create Interest packet with AppParameters, use parameterize().
    */
   tlv::Value getAppParameters() const {
-    if (obj->params == nullptr) {
+    const detail::InterestParams* params = getParams();
+    if (params == nullptr) {
       return tlv::Value();
     }
-    return obj->params->appParameters;
+    return params->appParameters;
   }
 
   /**
@@ -330,7 +422,13 @@ public:
    * @pre only available on decoded packet.
    */
   const ISigInfo* getSigInfo() const {
-    return obj->params == nullptr ? nullptr : &obj->params->sigInfo;
+    const detail::InterestParams* params = getParams();
+    return params == nullptr ? nullptr : &params->sigInfo;
+  }
+
+  /** @brief Compute encoded size of the Interest without AppParameters. */
+  size_t encodedSize() const {
+    return tlv::sizeofTlv(TT::Interest, obj->name.encodedSize() + sizeofMiddle());
   }
 
   /** @brief Encode the Interest without AppParameters. */
@@ -342,6 +440,18 @@ public:
   /** @brief Result of Interest::sign operation. */
   using Signed = detail::SignedInterestRef;
 
+  /** @brief Result of Interest::forward operation. */
+  using Forwarded = detail::ForwardedInterestRef;
+
+  /**
+   * @brief Re-encode a decoded Interest for forwarding.
+   * @return an Encodable object. AppParameters and signature fields are copied as received.
+   *         Changes to Nonce, InterestLifetime, and HopLimit are reflected.
+   */
+  Forwarded forward() const {
+    return Forwarded(obj);
+  }
+
   /** @brief Result of Interest::parameterize operation. */
   class Parameterized : public detail::ParameterizedInterestRef {
   public:
@@ -393,33 +503,25 @@ public:
 
   /** @brief Decode packet. */
   bool decodeFrom(const Decoder::Tlv& input) {
-    return EvDecoder::decode(
-      input, {TT::Interest}, EvDecoder::def<TT::Name>(&obj->name),
-      EvDecoder::def<TT::CanBePrefix>([this](const Decoder::Tlv&) { setCanBePrefix(true); }),
-      EvDecoder::def<TT::MustBeFresh>([this](const Decoder::Tlv&) { setMustBeFresh(true); }),
-      EvDecoder::def<TT::ForwardingHint>(
-        [this](const Decoder::Tlv& d) { return detail::decodeFwHint(d, &obj->fwHint); }),
-      EvDecoder::defNni<TT::Nonce, tlv::NNI4>(&obj->nonce),
-      EvDecoder::defNni<TT::InterestLifetime>(&obj->lifetime),
-      EvDecoder::defNni<TT::HopLimit, tlv::NNI1>(&obj->hopLimit),
-      EvDecoder::def<TT::AppParameters>([this, &input](const Decoder::Tlv& d) {
-        obj->params = regionOf(obj).template make<detail::InterestParams>();
-        if (obj->params == nullptr) {
-          return false;
-        }
-        obj->params->allParams = tlv::Value(d.tlv, input.tlv + input.size);
-        return obj->params->appParameters.decodeFrom(d);
-      }),
-      EvDecoder::def<TT::ISigInfo>([this](const Decoder::Tlv& d) {
-        return obj->params != nullptr && obj->params->sigInfo.decodeFrom(d);
-      }),
-      EvDecoder::def<TT::ISigValue>([this](const Decoder::Tlv& d) {
-        if (obj->params == nullptr) {
-          return false;
-        }
-        obj->params->signedParams = tlv::Value(obj->params->allParams.begin(), d.tlv);
-        return obj->params->sigValue.decodeFrom(d);
-      }));
+    return decodeImpl(input) && (obj->params == nullptr || decodeParams(*obj->params));
+  }
+
+  /**
+   * @brief Decode packet, deferring AppParameters and signature fields.
+   *
+   * Name and other fields before AppParameters are decoded immediately. AppParameters, ISigInfo,
+   * and ISigValue are located but not parsed until first accessed via getAppParameters(),
+   * getSigInfo(), checkDigest(), or verify(). If they turn out to be malformed, the packet
+   * appears to have no AppParameters and cannot be verified.
+   */
+  bool decodeLazy(const Decoder::Tlv& input) {
+    if (!decodeImpl(input)) {
+      return false;
+    }
+    if (obj->params != nullptr) {
+      obj->params->isLazy = true;
+    }
+    return true;
   }
 
   /**
@@ -449,7 +551,8 @@ public:
    * It's unnecessary to call this method if you are going to use verify().
    */
   bool checkDigest() const {
-    if (obj->params == nullptr) {
+    const detail::InterestParams* params = getParams();
+    if (params == nullptr) {
       return false;
     }
     int posParamsDigest = findParamsDigest(obj->name);
@@ -460,7 +563,7 @@ public:
 
     uint8_t digest[NDNPH_SHA256_LEN];
     port::Sha256 hash;
-    hash.update(obj->params->allParams.begin(), obj->params->allParams.size());
+    hash.update(params->allParams.begin(), params->allParams.size());
     return hash.final(digest) &&
            port::TimingSafeEqual()(digest, sizeof(digest), paramsDigest.value(),
                                    paramsDigest.length());
@@ -481,10 +584,10 @@ public:
     if (static_cast<size_t>(posParamsDigest) != obj->name.size() - 1) {
       return false;
     }
+    const detail::InterestParams* params = getParams();
     auto signedName = obj->name.getPrefix(-1);
-    return key.verify(
-      {tlv::Value(signedName.value(), signedName.length()), obj->params->signedParams},
-      obj->params->sigValue.begin(), obj->params->sigValue.size());
+    return key.verify({tlv::Value(signedName.value(), signedName.length()), params->signedParams},
+                      params->sigValue.begin(), params->sigValue.size());
   }
 
   template<typename DataT>
@@ -505,6 +608,60 @@ public:
     return count;
   }
 #endif
+
+private:
+  /** @brief Decode packet, locating but not parsing AppParameters and signature fields. */
+  bool decodeImpl(const Decoder::Tlv& input) {
+    return EvDecoder::decode(
+      input, {TT::Interest},
+      EvDecoder::def<TT::Name>(&obj->name),
+      EvDecoder::def<TT::CanBePrefix>([this](const Decoder::Tlv&) { setCanBePrefix(true); }),
+      EvDecoder::def<TT::MustBeFresh>([this](const Decoder::Tlv&) { setMustBeFresh(true); }),
+      EvDecoder::def<TT::ForwardingHint>(
+        [this](const Decoder::Tlv& d) { return detail::decodeFwHint(d, &obj->fwHint); }),
+      EvDecoder::defNni<TT::Nonce, tlv::NNI4>(&obj->nonce),
+      EvDecoder::defNni<TT::InterestLifetime>(&obj->lifetime),
+      EvDecoder::def<TT::HopLimit>([this](const Decoder::Tlv& d) {
+        obj->hasHopLimit = true;
+        return tlv::NNI1::decode(d, obj->hopLimit);
+      }),
+      EvDecoder::def<TT::AppParameters>([this, &input](const Decoder::Tlv& d) {
+        obj->params = regionOf(obj).template make<detail::InterestParams>();
+        if (obj->params == nullptr) {
+          return false;
+        }
+        obj->params->allParams = tlv::Value(d.tlv, input.tlv + input.size);
+        return true;
+      }),
+      EvDecoder::def<TT::ISigInfo>([this](const Decoder::Tlv&) { return hasParams(); }),
+      EvDecoder::def<TT::ISigValue>([this](const Decoder::Tlv&) { return hasParams(); }));
+  }
+
+  bool hasParams() const {
+    return obj->params != nullptr;
+  }
+
+  /** @brief Parse AppParameters and signature fields. */
+  static bool decodeParams(detail::InterestParams& params) {
+    return EvDecoder::decodeValue(
+      params.allParams.makeDecoder(), EvDecoder::def<TT::AppParameters>(&params.appParameters),
+      EvDecoder::def<TT::ISigInfo>(&params.sigInfo),
+      EvDecoder::def<TT::ISigValue>([&params](const Decoder::Tlv& d) {
+        params.signedParams = tlv::Value(params.allParams.begin(), d.tlv);
+        return params.sigValue.decodeFrom(d);
+      }));
+  }
+
+  /** @brief Access AppParameters and signature fields, parsing them if deferred. */
+  const detail::InterestParams* getParams() const {
+    if (obj->params != nullptr && obj->params->isLazy) {
+      obj->params->isLazy = false;
+      if (!decodeParams(*obj->params)) {
+        obj->params = nullptr;
+      }
+    }
+    return obj->params;
+  }
 };
 
 #ifdef NDNPH_PRINT_OSTREAM
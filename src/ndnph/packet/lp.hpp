@@ -1,6 +1,7 @@
 #ifndef NDNPH_PACKET_LP_HPP
 #define NDNPH_PACKET_LP_HPP
 
+#include "../port/clock/port.hpp"
 #include "data.hpp"
 #include "interest.hpp"
 #include "nack.hpp"
@@ -103,8 +104,8 @@ private:
 class EncodableBase {
 public:
   /** @brief Maximum encoded size of L3 headers. */
-  using L3MaxSize =
-    std::integral_constant<size_t, 1 + 1 + NDNPH_PITTOKEN_MAX + NackHeader::MaxSize::value>;
+  using L3MaxSize = std::integral_constant<size_t, 1 + 1 + NDNPH_PITTOKEN_MAX +
+                                                      NackHeader::MaxSize::value + 3 + 1 + 1>;
 
   void encodeL3Header(Encoder& encoder) const {
     encoder.prepend(
@@ -117,18 +118,54 @@ public:
         if (nack) {
           encoder.prepend(nack);
         }
+      },
+      [this](Encoder& encoder) {
+        if (congestionMark > 0) {
+          encoder.prependTlv(TT::CongestionMark, tlv::NNI(congestionMark));
+        }
       });
   }
 
+  /**
+   * @brief Encode LpPacket headers for a payload of @p payloadSize octets.
+   *
+   * Nothing is encoded if the payload can be transmitted without an LpPacket wrapper.
+   */
+  void encodeHeaderTo(Encoder& encoder, size_t payloadSize) const {
+    StaticRegion<L3MaxSize::value> l3hRegion;
+    Encoder l3h(l3hRegion);
+    encodeL3Header(l3h);
+    if (!l3h) {
+      encoder.setError();
+      return;
+    }
+
+    if (frag.fragCount <= 1 && l3h.size() == 0) {
+      return;
+    }
+    size_t sizeBefore = encoder.size();
+    encoder.prependTypeLength(TT::LpPayload, payloadSize);
+    encoder.prepend(
+      [this](Encoder& encoder) {
+        if (frag.fragCount > 1) {
+          encoder.prepend(frag);
+        }
+      },
+      tlv::Value(l3h));
+    encoder.prependTypeLength(TT::LpPacket, encoder.size() - sizeBefore + payloadSize);
+  }
+
   void copyL3HeaderFrom(const EncodableBase& src) {
     pitToken = src.pitToken;
     nack = src.nack;
+    congestionMark = src.congestionMark;
   }
 
 public:
   FragmentHeader frag;
   PitToken pitToken;
   NackHeader nack;
+  uint8_t congestionMark = 0;
 };
 
 /**
@@ -141,6 +178,31 @@ public:
   explicit Encodable(Payload payload)
     : payload(std::move(payload)) {}
 
+  /**
+   * @brief Compute encoded size.
+   * @pre Payload has `size_t encodedSize() const` method.
+   */
+  size_t encodedSize() const {
+    size_t payloadSize = payload.encodedSize();
+    StaticRegion<FragmentHeader::MaxSize::value + L3MaxSize::value> hRegion;
+    Encoder h(hRegion);
+    h.prepend(
+      [this](Encoder& encoder) {
+        if (frag.fragCount > 1) {
+          encoder.prepend(frag);
+        }
+      },
+      [this](Encoder& encoder) { encodeL3Header(encoder); });
+    if (!h || payloadSize == 0) {
+      return 0;
+    }
+
+    if (h.size() == 0) {
+      return payloadSize;
+    }
+    return tlv::sizeofTlv(TT::LpPacket, h.size() + tlv::sizeofTlv(TT::LpPayload, payloadSize));
+  }
+
   void encodeTo(Encoder& encoder) const {
     StaticRegion<L3MaxSize::value> l3hRegion;
     Encoder l3h(l3hRegion);
@@ -175,9 +237,10 @@ public:
  */
 template<typename L3, typename R = Encodable<L3>>
 R
-encode(L3 l3, PitToken pitToken = {}) {
+encode(L3 l3, PitToken pitToken = {}, uint8_t congestionMark = 0) {
   R encodable(l3);
   encodable.pitToken = pitToken;
+  encodable.congestionMark = congestionMark;
   return encodable;
 }
 
@@ -186,8 +249,8 @@ encode(L3 l3, PitToken pitToken = {}) {
  * @return an Encodable object.
  */
 inline Encodable<Interest>
-encode(Nack nack, PitToken pitToken = {}) {
-  auto encodable = encode(nack.getInterest(), pitToken);
+encode(Nack nack, PitToken pitToken = {}, uint8_t congestionMark = 0) {
+  auto encodable = encode(nack.getInterest(), pitToken, congestionMark);
   encodable.nack = nack.getHeader();
   return encodable;
 }
@@ -200,6 +263,16 @@ public:
   public:
     using Encodable::Encodable;
 
+    /**
+     * @brief Encode everything except the payload.
+     *
+     * The packet is the encoded header followed by @c payload , which may be transmitted as
+     * two gathered buffers via @c Transport::sendv without copying the payload.
+     */
+    void encodeHeaderTo(Encoder& encoder) const {
+      EncodableBase::encodeHeaderTo(encoder, payload.size());
+    }
+
   public:
     const Fragment* next = nullptr;
   };
@@ -316,6 +389,7 @@ public:
   std::tuple<bool, L3Header> clone(Region& region) const {
     L3Header copy;
     copy.pitToken = pitToken;
+    copy.congestionMark = congestionMark;
     if (!nack) {
       return std::make_tuple(true, copy);
     }
@@ -326,6 +400,7 @@ public:
 public:
   PitToken pitToken;
   tlv::Value nack;
+  uint8_t congestionMark = 0;
 };
 
 /** @brief Decoded fragment. */
@@ -358,6 +433,8 @@ public:
     m_type = Type::None;
     m_l3header = L3Header();
     m_frag = FragmentHeader();
+    m_acks = tlv::Value();
+    m_hasTxSeq = false;
 
     switch (input.type) {
       case TT::Interest:
@@ -382,13 +459,21 @@ public:
         m_type = Type::Nack;
         m_l3header.nack = tlv::Value(d.tlv, d.size);
       }),
+      EvDecoder::defNni<TT::CongestionMark>(&m_l3header.congestionMark),
+      EvDecoder::def<TT::Ack, true>([this](const Decoder::Tlv& d) {
+        m_acks = tlv::Value(m_acks.size() == 0 ? d.tlv : m_acks.begin(), d.value + d.length);
+      }),
+      EvDecoder::def<TT::TxSequence>([this](const Decoder::Tlv& d) {
+        return m_hasTxSeq = tlv::NNI8::decode(d, m_txSeq);
+      }),
       EvDecoder::def<TT::LpPayload>(&m_payload));
     if (!ok) {
       return false;
     }
 
     m_type = classifyType();
-    return m_type != Type::None;
+    // LpPacket without payload is an IDLE packet that carries link layer fields only
+    return m_type != Type::None || m_payload.size() == 0;
   }
 
   /** @brief Determine L3 packet type. */
@@ -401,6 +486,27 @@ public:
     return m_l3header.pitToken;
   }
 
+  /** @brief Retrieve CongestionMark, or zero if absent. */
+  uint8_t getCongestionMark() const {
+    return m_l3header.congestionMark;
+  }
+
+  /**
+   * @brief Retrieve TxSequence field.
+   * @return whether TxSequence exists, and its value.
+   */
+  std::tuple<bool, uint64_t> getTxSequence() const {
+    return std::make_tuple(m_hasTxSeq, m_txSeq);
+  }
+
+  /**
+   * @brief Retrieve Ack fields.
+   * @return TLV elements that include every Ack field. Elements of other types should be skipped.
+   */
+  tlv::Value getAcks() const {
+    return m_acks;
+  }
+
   /**
    * @brief Retrieve fragment.
    * @pre getType() == Type::Fragment
@@ -415,18 +521,20 @@ public:
 
   /**
    * @brief Decode payload as Interest.
+   * @param lazy if true, use Interest::decodeLazy().
    * @pre getType() == Type::Interest
    */
-  bool decodeInterest(Interest interest) const {
-    return m_type == Type::Interest && m_payload.makeDecoder().decode(interest);
+  bool decodeInterest(Interest interest, bool lazy = false) const {
+    return m_type == Type::Interest && decodePayload(interest, lazy);
   }
 
   /**
    * @brief Decode payload as Data.
+   * @param lazy if true, use Data::decodeLazy().
    * @pre getType() == Type::Data
    */
-  bool decodeData(Data data) const {
-    return m_type == Type::Data && m_payload.makeDecoder().decode(data);
+  bool decodeData(Data data, bool lazy = false) const {
+    return m_type == Type::Data && decodePayload(data, lazy);
   }
 
   /**
@@ -441,6 +549,15 @@ public:
   }
 
 private:
+  template<typename Packet>
+  bool decodePayload(Packet& packet, bool lazy) const {
+    if (!lazy) {
+      return m_payload.makeDecoder().decode(packet);
+    }
+    Decoder::Tlv d;
+    return Decoder::readTlv(d, m_payload.begin(), m_payload.end()) && d && packet.decodeLazy(d);
+  }
+
   Type classifyType() const {
     if (m_frag.fragCount > 1) {
       return Type::Fragment;
@@ -463,6 +580,9 @@ private:
   FragmentHeader m_frag;
   L3Header m_l3header;
   tlv::Value m_payload;
+  tlv::Value m_acks;
+  uint64_t m_txSeq = 0;
+  bool m_hasTxSeq = false;
 };
 
 /**
@@ -554,6 +674,7 @@ private:
     std::copy(frag.payload.begin(), frag.payload.end(), &m_buffer[m_size]);
     m_size += frag.payload.size();
     ++m_nextFragIndex;
+    m_l3header.congestionMark = std::max(m_l3header.congestionMark, frag.l3header.congestionMark);
     return true;
   }
 
@@ -567,6 +688,267 @@ private:
   uint8_t m_fragCount = 0;
 };
 
+/**
+ * @brief NDNLPv2 reassembler that accepts out-of-order fragments of concurrent packets.
+ *
+ * Each partial packet is identified by sender endpointId and SeqNumBase. It occupies a buffer of
+ * maxFragCount slots, and each fragment is written in place into the slot of its FragIndex.
+ * Received fragments are tracked in a bitmap. When every fragment has arrived, the slots are
+ * compacted into a contiguous payload. Partial packets are discarded after a timeout; when all
+ * buffers are occupied, the oldest partial packet is evicted.
+ */
+class MultiReassembler {
+public:
+  struct Counters {
+    uint32_t nDelivered = 0;
+    uint32_t nDuplicates = 0;
+    uint32_t nRejected = 0;
+    uint32_t nTimeouts = 0;
+    uint32_t nEvictions = 0;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param maxFlows maximum number of concurrent partial packets.
+   * @param maxFragCount maximum FragCount of a packet, up to 64.
+   * @param maxFragSize maximum fragment payload size.
+   * @param timeout partial packet timeout in milliseconds.
+   *
+   * The memory budget is maxFlows*maxFragCount*maxFragSize octets, allocated upfront.
+   */
+  explicit MultiReassembler(int maxFlows = 4, int maxFragCount = 8, size_t maxFragSize = 1500,
+                            int timeout = 500)
+    : m_maxFlows(std::max(1, maxFlows))
+    , m_maxFragCount(std::min(std::max(1, maxFragCount), 64))
+    , m_maxFragSize(maxFragSize)
+    , m_timeout(timeout)
+    , m_flows(new Flow[m_maxFlows])
+    , m_lengths(new uint16_t[m_maxFlows * m_maxFragCount])
+    , m_buffer(new uint8_t[getMemoryBudget()]) {}
+
+  /** @brief Return size of reassembly buffers. */
+  size_t getMemoryBudget() const {
+    return static_cast<size_t>(m_maxFlows) * m_maxFragCount * m_maxFragSize;
+  }
+
+  /**
+   * @brief Add a fragment.
+   * @param frag decoded fragment.
+   * @param endpointId sender endpoint.
+   * @return reassembled packet if @p frag completes a packet; otherwise, a @c PacketClassify with
+   *         @c Type::None . The reassembled packet remains valid until @c discard() or the next
+   *         @c add() invocation.
+   */
+  PacketClassify add(const Fragment& frag, uint64_t endpointId = 0) {
+    discard();
+    if (frag.fragCount > m_maxFragCount || frag.fragIndex >= frag.fragCount ||
+        frag.payload.size() > m_maxFragSize) {
+      ++m_cnt.nRejected;
+      return PacketClassify();
+    }
+
+    Flow* flow = findFlow(endpointId, frag.getSeqNumBase(), frag.fragCount);
+    if (flow == nullptr) {
+      ++m_cnt.nRejected;
+      return PacketClassify();
+    }
+    uint64_t bit = static_cast<uint64_t>(1) << frag.fragIndex;
+    if ((flow->received & bit) != 0) {
+      ++m_cnt.nDuplicates;
+      return PacketClassify();
+    }
+
+    if (frag.fragIndex == 0) {
+      bool ok = false;
+      std::tie(ok, flow->l3header) = frag.l3header.clone(flow->l3region);
+      if (!ok) {
+        ++m_cnt.nRejected;
+        flow->fragCount = 0;
+        return PacketClassify();
+      }
+    }
+    flow->congestionMark = std::max(flow->congestionMark, frag.l3header.congestionMark);
+    int i = flow - &m_flows[0];
+    uint8_t* slots = &m_buffer[i * m_maxFragCount * m_maxFragSize];
+    uint16_t* lengths = &m_lengths[i * m_maxFragCount];
+    std::copy(frag.payload.begin(), frag.payload.end(), &slots[frag.fragIndex * m_maxFragSize]);
+    lengths[frag.fragIndex] = frag.payload.size();
+    flow->received |= bit;
+    if (++flow->nReceived < flow->fragCount) {
+      return PacketClassify();
+    }
+
+    size_t size = 0;
+    for (int fragIndex = 0; fragIndex < flow->fragCount; ++fragIndex) {
+      const uint8_t* slot = &slots[fragIndex * m_maxFragSize];
+      std::copy(slot, slot + lengths[fragIndex], &slots[size]);
+      size += lengths[fragIndex];
+    }
+    m_completed = flow;
+    ++m_cnt.nDelivered;
+    flow->l3header.congestionMark = flow->congestionMark;
+    return PacketClassify(flow->l3header, tlv::Value(slots, size));
+  }
+
+  /** @brief Release the buffer of the last reassembled packet. */
+  void discard() {
+    if (m_completed != nullptr) {
+      m_completed->fragCount = 0;
+      m_completed = nullptr;
+    }
+  }
+
+  Counters readCounters() const {
+    return m_cnt;
+  }
+
+private:
+  struct Flow {
+    uint64_t endpointId = 0;
+    uint64_t seqNumBase = 0;
+    uint64_t received = 0;
+    port::Clock::Time since;
+    L3Header l3header;
+    StaticRegion<NackHeader::MaxSize::value> l3region;
+    uint8_t fragCount = 0; ///< zero indicates unused buffer
+    uint8_t nReceived = 0;
+    uint8_t congestionMark = 0;
+  };
+
+  /**
+   * @brief Find or allocate the buffer of a partial packet.
+   * @return the buffer, or nullptr if FragCount differs from existing fragments.
+   */
+  Flow* findFlow(uint64_t endpointId, uint64_t seqNumBase, uint8_t fragCount) {
+    auto now = port::Clock::now();
+    Flow* victim = nullptr;
+    for (int i = 0; i < m_maxFlows; ++i) {
+      Flow& flow = m_flows[i];
+      if (flow.fragCount != 0 && port::Clock::sub(now, flow.since) > m_timeout) {
+        ++m_cnt.nTimeouts;
+        flow.fragCount = 0;
+      }
+      if (flow.fragCount == 0) {
+        if (victim == nullptr || victim->fragCount != 0) {
+          victim = &flow;
+        }
+      } else if (flow.endpointId == endpointId && flow.seqNumBase == seqNumBase) {
+        return flow.fragCount == fragCount ? &flow : nullptr;
+      } else if (victim == nullptr ||
+                 (victim->fragCount != 0 && port::Clock::isBefore(flow.since, victim->since))) {
+        victim = &flow;
+      }
+    }
+
+    if (victim->fragCount != 0) {
+      ++m_cnt.nEvictions;
+    }
+    victim->endpointId = endpointId;
+    victim->seqNumBase = seqNumBase;
+    victim->received = 0;
+    victim->since = now;
+    victim->l3header = L3Header();
+    victim->l3region.reset();
+    victim->fragCount = fragCount;
+    victim->nReceived = 0;
+    victim->congestionMark = 0;
+    return victim;
+  }
+
+private:
+  int m_maxFlows;
+  int m_maxFragCount;
+  size_t m_maxFragSize;
+  int m_timeout;
+  std::unique_ptr<Flow[]> m_flows;
+  std::unique_ptr<uint16_t[]> m_lengths;
+  std::unique_ptr<uint8_t[]> m_buffer;
+  Flow* m_completed = nullptr;
+  Counters m_cnt;
+};
+
+/**
+ * @brief Decoder of a burst of packets.
+ * @tparam capacity maximum number of packets in a burst.
+ *
+ * Every packet in the burst is classified first, and then Interests and Data are decoded in
+ * separate passes, so that each pass runs the same code path over consecutive packets.
+ * Nacks and fragments are classified but not decoded.
+ */
+template<size_t capacity>
+class BurstDecoder {
+public:
+  struct Entry {
+    PacketClassify classify;
+    Interest interest; ///< decoded Interest, or a null handle
+    Data data;         ///< decoded Data, or a null handle
+  };
+
+  /**
+   * @brief Classify and decode a burst of packets.
+   * @param region where decoded Interest and Data are allocated. It should be large enough for
+   *               the whole burst, and may be reset after the decoded packets are processed.
+   * @param wires packet wires; they must remain valid while the decoded packets are in use.
+   * @param count number of packets; packets beyond @p capacity are ignored.
+   * @param lazy if true, use Interest::decodeLazy() and Data::decodeLazy().
+   * @return number of entries.
+   */
+  size_t decode(Region& region, const tlv::Value* wires, size_t count, bool lazy = false) {
+    m_size = std::min(count, capacity);
+    for (size_t i = 0; i < m_size; ++i) {
+      Entry& entry = m_entries[i];
+      entry.interest = Interest();
+      entry.data = Data();
+      if (!wires[i].makeDecoder().decode(entry.classify)) {
+        entry.classify = PacketClassify();
+      }
+    }
+
+    for (size_t i = 0; i < m_size; ++i) {
+      Entry& entry = m_entries[i];
+      if (entry.classify.getType() != PacketClassify::Type::Interest) {
+        continue;
+      }
+      Interest interest = region.create<Interest>();
+      if (interest && entry.classify.decodeInterest(interest, lazy)) {
+        entry.interest = interest;
+      }
+    }
+
+    for (size_t i = 0; i < m_size; ++i) {
+      Entry& entry = m_entries[i];
+      if (entry.classify.getType() != PacketClassify::Type::Data) {
+        continue;
+      }
+      Data data = region.create<Data>();
+      if (data && entry.classify.decodeData(data, lazy)) {
+        entry.data = data;
+      }
+    }
+    return m_size;
+  }
+
+  size_t size() const {
+    return m_size;
+  }
+
+  const Entry* begin() const {
+    return m_entries.data();
+  }
+
+  const Entry* end() const {
+    return begin() + m_size;
+  }
+
+  const Entry& operator[](size_t i) const {
+    return m_entries[i];
+  }
+
+private:
+  std::array<Entry, capacity> m_entries;
+  size_t m_size = 0;
+};
+
 } // namespace lp
 } // namespace ndnph
 
@@ -1,6 +1,7 @@
 #ifndef NDNPH_PACKET_NAME_HPP
 #define NDNPH_PACKET_NAME_HPP
 
+#include "../core/hash.hpp"
 #include "../core/input-iterator-pointer-proxy.hpp"
 #include "component.hpp"
 
@@ -10,6 +11,12 @@ namespace ndnph {
  * @brief Name.
  *
  * This type is immutable, except `decodeFrom()` method.
+ *
+ * A Name may carry a component offset index allocated in a Region, which makes `operator[]` and
+ * `slice()` O(1) instead of O(n). The index is shared by slices of the same Name.
+ * It is opt-in: names of decoded packets have no index, and `withIndex()` adds one.
+ * It also caches the hash of every prefix, which makes `getPrefixHash()` O(1) on the Name and
+ * its prefixes.
  */
 class Name : public Printable {
 public:
@@ -39,7 +46,7 @@ public:
 
   /**
    * @brief Parse from URI.
-   * @param region memory region; must have @c 2*strlen(uri) available room.
+   * @param region memory region; must have room for the encoded TLV-VALUE.
    * @param uri URI in canonical format; scheme and authority must be omitted;
    *            `8=` prefix of GenericNameComponent may be omitted.
    * @return name; it's valid if !name is false.
@@ -48,24 +55,17 @@ public:
    */
   static Name parse(Region& region, const char* uri) {
     size_t uriLen = std::strlen(uri);
-    size_t bufLen = 2 * uriLen;
-    uint8_t* buf = region.alloc(bufLen);
-    if (buf == nullptr) {
-      return Name();
-    }
-
     size_t nComps = 0;
-    ssize_t length = parseUri(buf, bufLen, uri, uriLen, nComps);
-    if (length < 0) {
-      region.free(buf, bufLen);
+    ssize_t length = parseUri(nullptr, 0, uri, uriLen, nComps);
+    if (length <= 0) {
       return Name();
     }
 
-    uint8_t* value = buf + bufLen - length;
-    if (value != buf) {
-      std::copy_backward(buf, buf + length, value + length);
-      region.free(buf, bufLen - length);
+    uint8_t* value = region.alloc(length);
+    if (value == nullptr) {
+      return Name();
     }
+    parseUri(value, length, uri, uriLen, nComps);
     return Name(value, length, nComps);
   }
 
@@ -87,6 +87,24 @@ public:
     return m_nComps;
   }
 
+  /** @brief Determine whether this Name has a component offset index. */
+  bool hasIndex() const {
+    return m_index != nullptr;
+  }
+
+  /**
+   * @brief Build component offset index.
+   * @return copy of this Name with an index allocated in @p region ;
+   *         if allocation fails, the copy has no index but is otherwise usable.
+   */
+  Name withIndex(Region& region) const {
+    Name indexed = *this;
+    if (!hasPrefixHashes()) {
+      indexed.buildIndex(region);
+    }
+    return indexed;
+  }
+
   /** @brief Iterator over name components. */
   class Iterator : public Decoder::Iterator {
   public:
@@ -129,6 +147,9 @@ public:
     if (isOutOfRange(i)) {
       return Component();
     }
+    if (m_index != nullptr) {
+      return Component::constant(m_value + m_index[i] - m_index[0], m_index[i + 1] - m_index[i]);
+    }
     auto it = begin();
     std::advance(it, i);
     return *it;
@@ -149,6 +170,12 @@ public:
     if (isOutOfRange(first) || isOutOfRange(last, true) || first >= last) {
       return Name();
     }
+    if (m_index != nullptr) {
+      Name sliced(m_value + m_index[first] - m_index[0], m_index[last] - m_index[first],
+                  last - first);
+      sliced.m_index = &m_index[first];
+      return sliced;
+    }
 
     auto it = begin();
     std::advance(it, first);
@@ -166,6 +193,30 @@ public:
     return slice(0, n);
   }
 
+  /**
+   * @brief Compute hash of a prefix.
+   * @param n number of components; if non-positive, count from end.
+   * @return FNV-1a hash of TLV-VALUE of `getPrefix(n)`, or 0 if @p n is out of range.
+   *
+   * Hashes of all prefixes are computed in one pass when building the index, so that a
+   * longest prefix match can probe a hash table with every prefix without rehashing.
+   */
+  uint32_t getPrefixHash(int n = 0) const {
+    if (n <= 0) {
+      n += m_nComps;
+    }
+    if (isOutOfRange(n, true)) {
+      return 0;
+    }
+    if (hasPrefixHashes()) {
+      return prefixHashAt(n);
+    }
+    if (n == static_cast<int>(m_nComps)) { // whole name, no need to parse components
+      return detail::fnv1a(m_value, m_length);
+    }
+    return detail::fnv1a(m_value, n == 0 ? 0 : getPrefix(n).length());
+  }
+
   /**
    * @brief Append a sequence of components.
    * @param comps a mix of Components and Convention+argument pairs.
@@ -235,12 +286,33 @@ public:
     return CMP_EQUAL;
   }
 
+  /**
+   * @brief Determine whether this name equals other.
+   *
+   * If both names have cached hashes, unequal names are usually rejected without comparing
+   * TLV-VALUE.
+   */
+  bool equals(const Name& other) const {
+    if (m_length != other.m_length) {
+      return false;
+    }
+    if (hasPrefixHashes() && other.hasPrefixHashes() &&
+        prefixHashAt(m_nComps) != other.prefixHashAt(other.m_nComps)) {
+      return false;
+    }
+    return m_length == 0 || std::equal(m_value, m_value + m_length, other.m_value);
+  }
+
   /** @brief Determine if this name is a prefix of other. */
   bool isPrefixOf(const Name& other) const {
     auto cmp = compare(other);
     return cmp == CMP_LPREFIX || cmp == CMP_EQUAL;
   }
 
+  size_t encodedSize() const {
+    return tlv::sizeofTlv(TT::Name, m_length);
+  }
+
   void encodeTo(Encoder& encoder) const {
     encoder.prependTlv(TT::Name, tlv::Value(m_value, m_length));
   }
@@ -249,6 +321,19 @@ public:
     return decodeValue(d.value, d.length);
   }
 
+  /**
+   * @brief Decode and build component offset index.
+   *
+   * Failure to allocate the index does not fail decoding.
+   */
+  bool decodeWithIndex(const Decoder::Tlv& d, Region& region) {
+    if (!decodeValue(d.value, d.length)) {
+      return false;
+    }
+    buildIndex(region);
+    return true;
+  }
+
 #ifdef NDNPH_PRINT_ARDUINO
   /** @brief Print name as URI. */
   size_t printTo(::Print& p) const final {
@@ -274,6 +359,8 @@ private:
 
   bool decodeValue(const uint8_t* value, size_t length) {
     m_value = value;
+    m_length = m_nComps = 0;
+    m_index = nullptr;
     if (decodeComps(length)) {
       return true;
     }
@@ -296,11 +383,59 @@ private:
     return !it.hasError();
   }
 
+  /**
+   * @brief Allocate and populate component offset index.
+   *
+   * Offsets are relative to the start of the indexed name, so that a slice can reference a
+   * subrange of its parent's index. Entry @c m_nComps has the end offset.
+   *
+   * Prefix hashes are stored in reverse order immediately before the offsets, so that a prefix
+   * can find them without knowing the parent's component count. A slice whose first offset is
+   * non-zero does not start at the parent's first component, and cannot use them.
+   */
+  void buildIndex(Region& region) {
+    if (m_nComps == 0 || m_length > std::numeric_limits<uint16_t>::max()) {
+      return;
+    }
+    size_t nEntries = m_nComps + 1;
+    uint8_t* room = region.allocA((sizeof(uint32_t) + sizeof(uint16_t)) * nEntries);
+    if (room == nullptr) {
+      return;
+    }
+    auto hash = reinterpret_cast<uint32_t*>(room) + nEntries;
+    auto index = reinterpret_cast<uint16_t*>(hash);
+    uint16_t* offset = index;
+    uint32_t h = detail::Fnv1aBasis::value;
+    for (const auto& d : Decoder(m_value, m_length)) {
+      *offset++ = static_cast<uint16_t>(d.tlv - m_value);
+      *--hash = h;
+      h = detail::fnv1a(d.tlv, d.size, h);
+    }
+    *offset = static_cast<uint16_t>(m_length);
+    *--hash = h;
+    m_index = index;
+  }
+
+  /** @brief Determine whether prefix hashes are available in the index. */
+  bool hasPrefixHashes() const {
+    return m_index != nullptr && m_index[0] == 0;
+  }
+
+  /** @brief Retrieve hash of the first @p n components; requires @c hasPrefixHashes() . */
+  uint32_t prefixHashAt(size_t n) const {
+    return reinterpret_cast<const uint32_t*>(m_index)[-1 - static_cast<ptrdiff_t>(n)];
+  }
+
   bool isOutOfRange(int i, bool acceptPastEnd = false) const {
     return i < 0 ||
            (acceptPastEnd ? i > static_cast<int>(m_nComps) : i >= static_cast<int>(m_nComps));
   }
 
+  /**
+   * @brief Parse URI into TLV-VALUE.
+   * @param buf output buffer, or nullptr to compute TLV-LENGTH only.
+   * @return TLV-LENGTH, or -1 if URI is invalid or @p buf is too small.
+   */
   static ssize_t parseUri(uint8_t* buf, size_t bufLen, const char* uri, size_t uriLen,
                           size_t& nComps) {
     nComps = 0;
@@ -311,17 +446,21 @@ private:
     size_t length = 0;
     while (uri < uriEnd) {
       ++uri; // skip '/'
-      const char* compEnd = std::strchr(uri, '/');
-      if (compEnd == nullptr) {
-        compEnd = uriEnd;
-      }
-
-      auto comp = Component::parse(buf + length, bufLen - length, uri, compEnd - uri);
-      if (!comp) {
+      const char* compEnd = std::find(uri, uriEnd, '/');
+      auto scan = detail::scanComponentUri(uri, compEnd);
+      if (scan.type == 0) {
         return -1;
       }
+      if (buf == nullptr) {
+        length += tlv::sizeofTlv(scan.type, scan.length);
+      } else {
+        auto comp = Component::parse(buf + length, bufLen - length, scan);
+        if (!comp) {
+          return -1;
+        }
+        length += comp.size();
+      }
       ++nComps;
-      length += comp.size();
       uri = compEnd;
     }
     return length;
@@ -358,13 +497,14 @@ private:
 
 private:
   const uint8_t* m_value = nullptr;
-  size_t m_length = 0;
-  size_t m_nComps = 0;
+  const uint16_t* m_index = nullptr; ///< component offsets, preceded by prefix hashes
+  uint32_t m_length = 0;
+  uint32_t m_nComps = 0;
 };
 
 inline bool
 operator==(const Name& lhs, const Name& rhs) {
-  return lhs.compare(rhs) == Name::CMP_EQUAL;
+  return lhs.equals(rhs);
 }
 
 inline bool
@@ -30,6 +30,14 @@ public:
 protected:
   ~SigInfo() = default;
 
+  size_t sizeofImpl(uint32_t type) const {
+    size_t length = tlv::NniElement<>(TT::SigType, sigType).encodedSize() + extensions.size();
+    if (name.size() > 0) {
+      length += tlv::sizeofTlv(TT::KeyLocator, name.encodedSize());
+    }
+    return tlv::sizeofTlv(type, length);
+  }
+
   void encodeImpl(uint32_t type, Encoder& encoder) const {
     encoder.prependTlv(
       type, tlv::NniElement<>(TT::SigType, sigType),
@@ -50,6 +58,10 @@ public:
 /** @brief SignatureInfo on Interest. */
 class ISigInfo : public SigInfo {
 public:
+  size_t encodedSize() const {
+    return sizeofImpl(TT::ISigInfo);
+  }
+
   void encodeTo(Encoder& encoder) const {
     return encodeImpl(TT::ISigInfo, encoder);
   }
@@ -58,6 +70,10 @@ public:
 /** @brief SignatureInfo on Data. */
 class DSigInfo : public SigInfo {
 public:
+  size_t encodedSize() const {
+    return sizeofImpl(TT::DSigInfo);
+  }
+
   void encodeTo(Encoder& encoder) const {
     return encodeImpl(TT::DSigInfo, encoder);
   }
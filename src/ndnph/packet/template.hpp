@@ -0,0 +1,221 @@
+#ifndef NDNPH_PACKET_TEMPLATE_HPP
+#define NDNPH_PACKET_TEMPLATE_HPP
+
+#include "data.hpp"
+#include "interest.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief Pre-encoded Interest fields shared by many packets.
+ *
+ * Fields other than Name and Nonce are copied from a prototype Interest and encoded once.
+ * Each packet then encodes its Name and Nonce, and copies the pre-encoded fields.
+ * AppParameters are not supported.
+ */
+class InterestTemplate {
+public:
+  /** @brief Encoded size of Nonce element. */
+  using NonceSize = std::integral_constant<size_t, tlv::sizeofTlv(TT::Nonce, 4)>;
+
+  /** @brief Result of InterestTemplate::encode operation. */
+  class Encodable {
+  public:
+    size_t encodedSize() const {
+      if (!*tpl) {
+        return 0;
+      }
+      return tlv::sizeofTlv(TT::Interest, name.encodedSize() + tpl->m_beforeNonce.size() +
+                                            NonceSize::value + tpl->m_afterNonce.size());
+    }
+
+    void encodeTo(Encoder& encoder) const {
+      if (!*tpl) {
+        encoder.setError();
+        return;
+      }
+      encoder.prependTlv(TT::Interest, name, tpl->m_beforeNonce,
+                         tlv::NniElement<tlv::NNI4>(TT::Nonce, nonce), tpl->m_afterNonce);
+    }
+
+  public:
+    const InterestTemplate* tpl;
+    Name name;
+    uint32_t nonce;
+  };
+
+  explicit InterestTemplate() = default;
+
+  /**
+   * @brief Pre-encode fields of @p proto except Name and Nonce.
+   * @param region where pre-encoded fields are stored; it must outlive this template.
+   */
+  explicit InterestTemplate(Region& region, const Interest& proto) {
+    Encoder encoder(region);
+    encoder.prepend(proto);
+    encoder.trim();
+    Decoder::Tlv interest;
+    if (!encoder || !Decoder::readTlv(interest, encoder.begin(), encoder.end())) {
+      return;
+    }
+
+    const uint8_t* afterName = nullptr;
+    for (const auto& d : Decoder(interest.value, interest.length)) {
+      if (d.type == TT::Name) {
+        afterName = d.tlv + d.size;
+      } else if (d.type == TT::Nonce) {
+        m_beforeNonce = tlv::Value(afterName, d.tlv);
+        m_afterNonce = tlv::Value(d.tlv + d.size, interest.value + interest.length);
+        m_valid = afterName != nullptr;
+        return;
+      }
+    }
+  }
+
+  /** @brief Return true if the template was constructed successfully. */
+  explicit operator bool() const {
+    return m_valid;
+  }
+
+  /** @brief Encode an Interest with given Name and Nonce. */
+  Encodable encode(const Name& name, uint32_t nonce) const {
+    return Encodable{this, name, nonce};
+  }
+
+  /** @brief Encode an Interest with given Name and random Nonce. */
+  Encodable encode(const Name& name) const {
+    uint32_t nonce = 0;
+    port::RandomSource::generate(reinterpret_cast<uint8_t*>(&nonce), sizeof(nonce));
+    return encode(name, nonce);
+  }
+
+private:
+  tlv::Value m_beforeNonce;
+  tlv::Value m_afterNonce;
+  bool m_valid = false;
+};
+
+/**
+ * @brief Pre-encoded Data fields shared by many packets.
+ *
+ * MetaInfo fields other than FinalBlock are copied from a prototype Data, and SignatureInfo is
+ * obtained from the signing key; both are encoded once. Each packet then encodes its Name,
+ * Content, optional FinalBlock, and signature, and copies the pre-encoded fields.
+ */
+class DataTemplate {
+public:
+  /** @brief Result of DataTemplate::encode operation. */
+  class Encodable {
+  public:
+    /**
+     * @brief Compute encoded size.
+     * @return exact size if the key has fixed signature length, otherwise an upper bound.
+     */
+    size_t encodedSize() const {
+      if (!*tpl) {
+        return 0;
+      }
+      size_t metaInfo = tpl->m_metaInfo.size();
+      if (isFinalBlock) {
+        metaInfo += tlv::sizeofTlv(TT::FinalBlock, name[-1].size());
+      }
+      size_t size = name.encodedSize() + tpl->m_sigInfo.size() +
+                    tlv::sizeofTlv(TT::DSigValue, tpl->m_key->getMaxSigLen());
+      if (metaInfo > 0) {
+        size += tlv::sizeofTlv(TT::MetaInfo, metaInfo);
+      }
+      if (content.size() > 0) {
+        size += tlv::sizeofTlv(TT::Content, content.size());
+      }
+      return tlv::sizeofTlv(TT::Data, size);
+    }
+
+    void encodeTo(Encoder& encoder) const {
+      if (!*tpl) {
+        encoder.setError();
+        return;
+      }
+      detail::encodeSignedData(encoder, *tpl->m_key, [this](Encoder& encoder) {
+        encoder.prepend(
+          name,
+          [this](Encoder& encoder) {
+            encoder.prependTlv(TT::MetaInfo, Encoder::OmitEmpty, tpl->m_metaInfo,
+                               [this](Encoder& encoder) {
+                                 if (isFinalBlock) {
+                                   auto comp = name[-1];
+                                   encoder.prependTlv(TT::FinalBlock,
+                                                      tlv::Value(comp.tlv(), comp.size()));
+                                 }
+                               });
+          },
+          [this](Encoder& encoder) {
+            encoder.prependTlv(TT::Content, Encoder::OmitEmpty, content);
+          },
+          tpl->m_sigInfo);
+      });
+    }
+
+  public:
+    const DataTemplate* tpl;
+    Name name;
+    tlv::Value content;
+    bool isFinalBlock;
+  };
+
+  explicit DataTemplate() = default;
+
+  /**
+   * @brief Pre-encode MetaInfo of @p proto and SignatureInfo of @p key.
+   * @param region where pre-encoded fields are stored; it must outlive this template.
+   */
+  explicit DataTemplate(Region& region, const Data& proto, const PrivateKey& key) {
+    DSigInfo sigInfo;
+    key.updateSigInfo(sigInfo);
+
+    Encoder encoder(region);
+    encoder.prepend(sigInfo);
+    const uint8_t* afterMetaInfo = encoder.begin();
+    encoder.prepend(
+      [&](Encoder& encoder) {
+        if (proto.getContentType() != detail::DataObj::DefaultContentType) {
+          encoder.prependTlv(TT::ContentType, tlv::NNI(proto.getContentType()));
+        }
+      },
+      [&](Encoder& encoder) {
+        if (proto.getFreshnessPeriod() != detail::DataObj::DefaultFreshnessPeriod) {
+          encoder.prependTlv(TT::FreshnessPeriod, tlv::NNI(proto.getFreshnessPeriod()));
+        }
+      });
+    encoder.trim();
+    if (!encoder) {
+      return;
+    }
+
+    m_metaInfo = tlv::Value(encoder.begin(), afterMetaInfo);
+    m_sigInfo = tlv::Value(afterMetaInfo, encoder.end());
+    m_key = &key;
+  }
+
+  /** @brief Return true if the template was constructed successfully. */
+  explicit operator bool() const {
+    return m_key != nullptr;
+  }
+
+  /**
+   * @brief Encode and sign a Data with given Name and Content.
+   * @param isFinalBlock whether to set FinalBlock to the last component of @p name .
+   */
+  Encodable encode(const Name& name, tlv::Value content = tlv::Value(),
+                   bool isFinalBlock = false) const {
+    return Encodable{this, name, std::move(content), isFinalBlock};
+  }
+
+private:
+  tlv::Value m_metaInfo;
+  tlv::Value m_sigInfo;
+  const PrivateKey* m_key = nullptr;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_PACKET_TEMPLATE_HPP
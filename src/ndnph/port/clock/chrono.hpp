@@ -30,6 +30,11 @@ public:
     return std::chrono::duration_cast<std::chrono::milliseconds>(a - b).count();
   }
 
+  /** @brief Compute a - b in microseconds. */
+  static int64_t subMicros(Time a, Time b) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(a - b).count();
+  }
+
   static bool isBefore(Time a, Time b) {
     return a < b;
   }
@@ -39,6 +39,14 @@ public:
     return static_cast<int>(diff);
   }
 
+  /**
+   * @brief Compute a - b in microseconds.
+   * @note Resolution is limited to milliseconds.
+   */
+  static int64_t subMicros(Time a, Time b) {
+    return static_cast<int64_t>(sub(a, b)) * 1000;
+  }
+
   static bool isBefore(Time a, Time b) {
     static_assert(std::is_unsigned<TimeMillis>::value, "");
     auto diff = a.ms - b.ms;
@@ -2,9 +2,11 @@
 #define NDNPH_PORT_FS_LINUX_HPP
 
 #include "../../core/common.hpp"
+#include <dirent.h>
 #include <fcntl.h>
 #include <libgen.h>
 #include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -80,18 +82,90 @@ public:
     }
   }
 
+  /** @brief Give up ownership of the file descriptor. */
+  int release() {
+    int fd = m_fd;
+    m_fd = -1;
+    return fd;
+  }
+
 private:
   int m_fd = -1;
 };
 
+/** @brief Singly linked list of file names. */
+class FilenameList {
+public:
+  bool contains(const char* filename) const {
+    for (const Node* node = m_head.get(); node != nullptr; node = node->next.get()) {
+      if (strcmp(node->filename.get(), filename) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void add(const char* filename) {
+    if (contains(filename)) {
+      return;
+    }
+    std::unique_ptr<Node> node(new Node);
+    node->filename.reset(new char[strlen(filename) + 1]);
+    strcpy(node->filename.get(), filename);
+    node->next = std::move(m_head);
+    m_head = std::move(node);
+  }
+
+  bool remove(const char* filename) {
+    for (std::unique_ptr<Node>* cur = &m_head; *cur != nullptr; cur = &(*cur)->next) {
+      if (strcmp((*cur)->filename.get(), filename) == 0) {
+        *cur = std::move((*cur)->next);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** @brief Remove the first file name and pass it to @p f . */
+  template<typename F>
+  bool pop(const F& f) {
+    if (m_head == nullptr) {
+      return false;
+    }
+    std::unique_ptr<Node> node = std::move(m_head);
+    m_head = std::move(node->next);
+    f(node->filename.get());
+    return true;
+  }
+
+private:
+  struct Node {
+    std::unique_ptr<char[]> filename;
+    std::unique_ptr<Node> next;
+  };
+  std::unique_ptr<Node> m_head;
+};
+
 } // namespace detail
 
 /** @brief File storage on Linux filesystem. */
 class FileStore {
 public:
+  explicit FileStore() = default;
+
+  FileStore(const FileStore&) = delete;
+  FileStore& operator=(const FileStore&) = delete;
+
+  /** @brief Discard an uncommitted batch. */
+  ~FileStore() {
+    discardPending();
+  }
+
   /**
    * @brief Open @p path directory as FileStore, creating directories as necessary.
    * @return whether success.
+   *
+   * Temporary files left over from an uncommitted batch are deleted.
    */
   bool open(const char* path) {
     if (!detail::Mkdirp().create(path)) {
@@ -99,7 +173,11 @@ public:
     }
 
     m_dfd = ::open(path, O_RDONLY | O_DIRECTORY);
-    return m_dfd >= 0;
+    if (m_dfd < 0) {
+      return false;
+    }
+    deleteTempFiles();
+    return true;
   }
 
   /**
@@ -128,24 +206,411 @@ public:
   /**
    * @brief Write @p buffer into @p filename file.
    * @return whether success.
+   *
+   * The content is written to a temporary file, which then atomically replaces @p filename file.
+   * Outside a batch, the write is durable when this function returns.
    */
   bool write(const char* filename, const uint8_t* buffer, size_t count) {
-    detail::FdCloser fd(::openat(m_dfd, filename, O_WRONLY | O_CREAT, 0600));
-    ssize_t nWrite = ::write(fd, buffer, count);
-    return static_cast<size_t>(nWrite) == count;
+    char temp[NAME_MAX + 1];
+    if (!makeTempName(temp, filename)) {
+      return false;
+    }
+    detail::FdCloser fd(::openat(m_dfd, temp, O_WRONLY | O_CREAT | O_TRUNC, 0600));
+    if (fd < 0) {
+      return false;
+    }
+    if (!writeAll(fd, buffer, count) || (!m_inBatch && ::fdatasync(fd) != 0)) {
+      ::unlinkat(m_dfd, temp, 0);
+      return false;
+    }
+    fd.close();
+
+    if (m_inBatch) {
+      m_pending.add(filename);
+      m_deletions.remove(filename);
+      return true;
+    }
+    return ::renameat(m_dfd, temp, m_dfd, filename) == 0 && ::fsync(m_dfd) == 0;
   }
 
   /**
    * @brief Delete @p filename file.
    * @return whether success.
+   *
+   * Within a batch, the deletion is deferred until @c commitBatch() .
    */
   bool unlink(const char* filename) {
+    char temp[NAME_MAX + 1];
+    if (m_pending.remove(filename) && makeTempName(temp, filename)) {
+      ::unlinkat(m_dfd, temp, 0);
+    }
+    if (m_inBatch) {
+      m_deletions.add(filename);
+      return true;
+    }
     int res = ::unlinkat(m_dfd, filename, 0);
     return res == 0 || errno == ENOENT;
   }
 
+  /**
+   * @brief Start a batch of writes and deletions.
+   *
+   * Within a batch, @c write() skips flushing to storage device, and the written content becomes
+   * visible upon @c commitBatch() ; @c unlink() takes effect upon @c commitBatch() . If the
+   * process crashes before that, every file in the batch retains its old content.
+   */
+  void beginBatch() {
+    m_inBatch = true;
+  }
+
+  /**
+   * @brief Commit a batch of writes and deletions.
+   * @return whether success.
+   *
+   * All written files are flushed with one @c syncfs , and then renamed into place.
+   * Deleted files are then unlinked. If flushing fails, the whole batch is discarded.
+   */
+  bool commitBatch() {
+    m_inBatch = false;
+    if (::syncfs(m_dfd) != 0) {
+      discardPending();
+      return false;
+    }
+
+    bool ok = true;
+    while (m_pending.pop([&](const char* filename) {
+      char temp[NAME_MAX + 1];
+      makeTempName(temp, filename);
+      ok = ::renameat(m_dfd, temp, m_dfd, filename) == 0 && ok;
+    })) {
+    }
+    while (m_deletions.pop([&](const char* filename) {
+      ok = (::unlinkat(m_dfd, filename, 0) == 0 || errno == ENOENT) && ok;
+    })) {
+    }
+    return ok && ::fsync(m_dfd) == 0;
+  }
+
+  /**
+   * @brief Map @p filename file into @p mapping .
+   * @return whether success.
+   */
+  template<typename Mapping>
+  bool map(const char* filename, Mapping& mapping) {
+    detail::FdCloser fd(::openat(m_dfd, filename, O_RDONLY));
+    return fd >= 0 && mapping.open(fd);
+  }
+
+private:
+  void discardPending() {
+    while (m_pending.pop([this](const char* filename) {
+      char temp[NAME_MAX + 1];
+      makeTempName(temp, filename);
+      ::unlinkat(m_dfd, temp, 0);
+    })) {
+    }
+    while (m_deletions.pop([](const char*) {})) {
+    }
+  }
+
+  /** @brief Delete temporary files, which could be left over if a process crashed in a batch. */
+  void deleteTempFiles() {
+    DIR* dir = ::fdopendir(::dup(m_dfd));
+    if (dir == nullptr) {
+      return;
+    }
+    static const char suffix[] = ".tmp";
+    while (const struct dirent* entry = ::readdir(dir)) {
+      size_t nameLen = strlen(entry->d_name);
+      if (nameLen > sizeof(suffix) - 1 &&
+          strcmp(&entry->d_name[nameLen - sizeof(suffix) + 1], suffix) == 0) {
+        ::unlinkat(m_dfd, entry->d_name, 0);
+      }
+    }
+    ::closedir(dir);
+  }
+
+  static bool makeTempName(char* temp, const char* filename) {
+    static const char suffix[] = ".tmp";
+    size_t filenameLen = strlen(filename);
+    if (filenameLen + sizeof(suffix) > NAME_MAX + 1) {
+      return false;
+    }
+    std::copy_n(filename, filenameLen, temp);
+    std::copy_n(suffix, sizeof(suffix), &temp[filenameLen]);
+    return true;
+  }
+
+  static bool writeAll(int fd, const uint8_t* buffer, size_t count) {
+    while (count > 0) {
+      ssize_t nWrite = ::write(fd, buffer, count);
+      if (nWrite < 0 && errno == EINTR) {
+        continue;
+      }
+      if (nWrite <= 0) {
+        return false;
+      }
+      buffer += nWrite;
+      count -= nWrite;
+    }
+    return true;
+  }
+
 private:
   detail::FdCloser m_dfd;
+  detail::FilenameList m_pending;   ///< files written in current batch
+  detail::FilenameList m_deletions; ///< files deleted in current batch
+  bool m_inBatch = false;
+};
+
+/** @brief Read-only memory mapping of a file on Linux filesystem. */
+class FileMapping {
+public:
+  /** @brief Access pattern hint. */
+  enum Advice {
+    AdviceNormal = MADV_NORMAL,
+    AdviceSequential = MADV_SEQUENTIAL,
+    AdviceWillNeed = MADV_WILLNEED,
+    AdviceDontNeed = MADV_DONTNEED,
+  };
+
+  explicit FileMapping() = default;
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+
+  ~FileMapping() {
+    close();
+  }
+
+  /**
+   * @brief Map @p path file.
+   * @return whether success.
+   */
+  bool open(const char* path) {
+    detail::FdCloser fd(::open(path, O_RDONLY));
+    return fd >= 0 && open(fd);
+  }
+
+  /**
+   * @brief Map file referenced by @p fd .
+   * @return whether success.
+   *
+   * The caller retains ownership of @p fd . It may be closed after this function returns.
+   */
+  bool open(int fd) {
+    close();
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      return false;
+    }
+
+    m_size = st.st_size;
+    if (m_size == 0) { // mmap rejects zero length
+      return true;
+    }
+
+    void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+      m_size = 0;
+      return false;
+    }
+    m_addr = static_cast<uint8_t*>(addr);
+    return true;
+  }
+
+  /** @brief Unmap the file. */
+  void close() {
+    if (m_addr != nullptr) {
+      ::munmap(m_addr, m_size);
+    }
+    m_addr = nullptr;
+    m_size = 0;
+  }
+
+  /**
+   * @brief Get pointer to file content.
+   * @retval nullptr file is not mapped or is empty.
+   */
+  const uint8_t* data() const {
+    return m_addr;
+  }
+
+  /** @brief Get file size. */
+  size_t size() const {
+    return m_size;
+  }
+
+  /**
+   * @brief Give access pattern hint over a byte range.
+   * @param offset range offset; it is rounded down to page boundary.
+   * @param length range length; it is clipped at end of file.
+   * @return whether success.
+   */
+  bool advise(size_t offset, size_t length, Advice advice) {
+    if (m_addr == nullptr || offset >= m_size) {
+      return false;
+    }
+    size_t pageOffset = offset - offset % static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    length = std::min(length, m_size - offset) + (offset - pageOffset);
+    return ::madvise(m_addr + pageOffset, length, static_cast<int>(advice)) == 0;
+  }
+
+  /** @brief Give access pattern hint over the whole file. */
+  bool advise(Advice advice) {
+    return advise(0, m_size, advice);
+  }
+
+private:
+  uint8_t* m_addr = nullptr;
+  size_t m_size = 0;
+};
+
+/** @brief Append-only file on Linux filesystem. */
+class AppendFile {
+public:
+  explicit AppendFile() = default;
+
+  AppendFile(const AppendFile&) = delete;
+  AppendFile& operator=(const AppendFile&) = delete;
+
+  /**
+   * @brief Open or create @p path file.
+   * @return whether success.
+   *
+   * A leftover temporary file from an interrupted @c openTemp() is deleted.
+   */
+  bool open(const char* path) {
+    close();
+    size_t pathLen = strlen(path);
+    if (pathLen == 0 || pathLen + sizeof(".tmp") > sizeof(m_path)) {
+      return false;
+    }
+    std::copy_n(path, pathLen + 1, m_path);
+    char temp[PATH_MAX];
+    ::unlink(makeTempPath(temp, m_path));
+    return openFd(m_path, O_RDWR | O_CREAT);
+  }
+
+  /**
+   * @brief Create an empty temporary file next to @p base file.
+   * @return whether success.
+   * @sa commit()
+   */
+  bool openTemp(const AppendFile& base) {
+    close();
+    if (base.m_fd < 0) {
+      return false;
+    }
+    makeTempPath(m_path, base.m_path);
+    return openFd(m_path, O_RDWR | O_CREAT | O_TRUNC);
+  }
+
+  /**
+   * @brief Atomically replace @p base file with this temporary file.
+   * @return whether success.
+   * @post Upon success, @p base refers to the new file, and this object is closed.
+   */
+  bool commit(AppendFile& base) {
+    if (m_fd < 0 || !sync() || ::rename(m_path, base.m_path) != 0) {
+      return false;
+    }
+    base.m_fd = m_fd.release();
+    base.m_size = m_size;
+    syncDir(base.m_path);
+    close();
+    return true;
+  }
+
+  /** @brief Close the file. */
+  void close() {
+    m_fd.close();
+    m_size = 0;
+  }
+
+  /** @brief Get file size. */
+  size_t size() const {
+    return m_size;
+  }
+
+  /**
+   * @brief Read from @p offset into @p buffer .
+   * @return number of octets read; negative upon error.
+   */
+  int read(size_t offset, uint8_t* buffer, size_t count) {
+    ssize_t nRead = ::pread(m_fd, buffer, count, offset);
+    return nRead < 0 ? -errno : static_cast<int>(nRead);
+  }
+
+  /**
+   * @brief Append @p buffer at end of file.
+   * @return whether success.
+   *
+   * Upon failure, a partially written tail is truncated.
+   */
+  bool append(const uint8_t* buffer, size_t count) {
+    ssize_t nWrite = ::pwrite(m_fd, buffer, count, m_size);
+    if (static_cast<size_t>(nWrite) != count) {
+      truncate(m_size);
+      return false;
+    }
+    m_size += count;
+    return true;
+  }
+
+  /**
+   * @brief Discard file content after @p size octets.
+   * @return whether success.
+   */
+  bool truncate(size_t size) {
+    if (::ftruncate(m_fd, size) != 0) {
+      return false;
+    }
+    m_size = size;
+    return true;
+  }
+
+  /**
+   * @brief Flush written content to storage device.
+   * @return whether success.
+   */
+  bool sync() {
+    return ::fdatasync(m_fd) == 0;
+  }
+
+private:
+  static const char* makeTempPath(char* temp, const char* path) {
+    static const char suffix[] = ".tmp";
+    size_t pathLen = strlen(path);
+    std::copy_n(path, pathLen, temp);
+    std::copy_n(suffix, sizeof(suffix), &temp[pathLen]);
+    return temp;
+  }
+
+  static void syncDir(const char* path) {
+    char dir[PATH_MAX];
+    strncpy(dir, path, sizeof(dir));
+    detail::FdCloser dfd(::open(::dirname(dir), O_RDONLY | O_DIRECTORY));
+    if (dfd >= 0) {
+      ::fsync(dfd);
+    }
+  }
+
+  bool openFd(const char* path, int flags) {
+    m_fd = ::open(path, flags | O_CLOEXEC, 0600);
+    struct stat st;
+    if (m_fd < 0 || ::fstat(m_fd, &st) != 0) {
+      close();
+      return false;
+    }
+    m_size = st.st_size;
+    return true;
+  }
+
+private:
+  detail::FdCloser m_fd;
+  size_t m_size = 0;
+  char m_path[PATH_MAX];
 };
 
 } // namespace port_fs_linux
@@ -153,6 +618,8 @@ private:
 #ifdef NDNPH_PORT_FS_LINUX
 namespace port {
 using FileStore = port_fs_linux::FileStore;
+using FileMapping = port_fs_linux::FileMapping;
+using AppendFile = port_fs_linux::AppendFile;
 } // namespace port
 #endif
 
@@ -55,6 +55,158 @@ public:
     (void)filename;
     return true;
   }
+
+  /**
+   * @brief Start a batch of writes and deletions.
+   *
+   * Written content and deletions should become visible and durable upon @c commitBatch() .
+   */
+  void beginBatch() {}
+
+  /**
+   * @brief Commit a batch of writes and deletions.
+   * @return whether success.
+   */
+  bool commitBatch() {
+    return true;
+  }
+
+  /**
+   * @brief Map a file into a FileMapping.
+   * @param filename file name; directories are not supported.
+   * @param mapping FileMapping instance.
+   * @return whether success; false if the port does not support memory mapping.
+   */
+  template<typename Mapping>
+  bool map(const char* filename, Mapping& mapping) {
+    (void)filename;
+    (void)mapping;
+    return false;
+  }
+};
+
+/** @brief Read-only file mapping stub. */
+class FileMapping {
+public:
+  /** @brief Access pattern hint. */
+  enum Advice {
+    AdviceNormal,
+    AdviceSequential,
+    AdviceWillNeed,
+    AdviceDontNeed,
+  };
+
+  /**
+   * @brief Map a file.
+   *
+   * Each port may have different arguments to this function.
+   */
+  bool open() {
+    return false;
+  }
+
+  /** @brief Unmap the file. */
+  void close() {}
+
+  /**
+   * @brief Get pointer to file content.
+   * @retval nullptr file is not mapped or is empty.
+   */
+  const uint8_t* data() const {
+    return nullptr;
+  }
+
+  /** @brief Get file size. */
+  size_t size() const {
+    return 0;
+  }
+
+  /**
+   * @brief Give access pattern hint over a byte range.
+   * @return whether success.
+   */
+  bool advise(size_t offset, size_t length, Advice advice) {
+    (void)offset;
+    (void)length;
+    (void)advice;
+    return false;
+  }
+
+  /** @brief Give access pattern hint over the whole file. */
+  bool advise(Advice advice) {
+    return advise(0, 0, advice);
+  }
+};
+
+/** @brief Append-only file stub. */
+class AppendFile {
+public:
+  /**
+   * @brief Open or create a file.
+   *
+   * Each port may have different arguments to this function.
+   */
+  bool open() {
+    return false;
+  }
+
+  /** @brief Create an empty temporary file next to @p base file. */
+  bool openTemp(const AppendFile& base) {
+    (void)base;
+    return false;
+  }
+
+  /** @brief Atomically replace @p base file with this temporary file. */
+  bool commit(AppendFile& base) {
+    (void)base;
+    return false;
+  }
+
+  /** @brief Close the file. */
+  void close() {}
+
+  /** @brief Get file size. */
+  size_t size() const {
+    return 0;
+  }
+
+  /**
+   * @brief Read from a file offset.
+   * @return number of octets read; negative upon error.
+   */
+  int read(size_t offset, uint8_t* buffer, size_t count) {
+    (void)offset;
+    (void)buffer;
+    (void)count;
+    return -1;
+  }
+
+  /**
+   * @brief Append at end of file.
+   * @return whether success.
+   */
+  bool append(const uint8_t* buffer, size_t count) {
+    (void)buffer;
+    (void)count;
+    return false;
+  }
+
+  /**
+   * @brief Discard file content after @p size octets.
+   * @return whether success.
+   */
+  bool truncate(size_t size) {
+    (void)size;
+    return false;
+  }
+
+  /**
+   * @brief Flush written content to storage device.
+   * @return whether success.
+   */
+  bool sync() {
+    return false;
+  }
 };
 
 } // namespace port_fs_null
@@ -62,6 +214,8 @@ public:
 #ifdef NDNPH_PORT_FS_NULL
 namespace port {
 using FileStore = port_fs_null::FileStore;
+using FileMapping = port_fs_null::FileMapping;
+using AppendFile = port_fs_null::AppendFile;
 } // namespace port
 #endif
 
@@ -152,7 +152,16 @@ private:
     }
   }
 
-  bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t) final {
+  bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) final {
+    IoVec iov{pkt, pktLen};
+    return doSendv(&iov, 1, endpointId);
+  }
+
+  bool doCanSendv() const final {
+    return true;
+  }
+
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t) final {
     if (!m_isUp) {
 #ifdef NDNPH_MEMIF_DEBUG
       fprintf(stderr, "MemifTransport send drop=transport-disconnected\n");
@@ -160,6 +169,7 @@ private:
       return false;
     }
 
+    size_t pktLen = iovLength(iov, iovcnt);
     if (pktLen > m_dataroom) {
 #ifdef NDNPH_MEMIF_DEBUG
       fprintf(stderr, "MemifTransport send drop=pkt-too-long len=%zu\n", pktLen);
@@ -177,7 +187,7 @@ private:
 
     NDNPH_ASSERT(b.len >= pktLen);
     NDNPH_ASSERT((b.flags & MEMIF_BUFFER_FLAG_NEXT) == 0);
-    std::copy_n(pkt, pktLen, static_cast<uint8_t*>(b.data));
+    iovGather(iov, iovcnt, static_cast<uint8_t*>(b.data));
     b.len = pktLen;
 
     uint16_t nTx = 0;
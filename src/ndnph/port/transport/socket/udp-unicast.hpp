@@ -142,21 +142,41 @@ private:
   }
 
   bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t endpointId) final {
+    IoVec iov{pkt, pktLen};
+    return doSendv(&iov, 1, endpointId);
+  }
+
+  bool doCanSendv() const final {
+    return true;
+  }
+
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId) final {
+    if (iovcnt > MaxIovCnt::value) {
+      return sendvByCopy(iov, iovcnt, endpointId);
+    }
+
     const auto& p = getAddressFamilyParams(m_af);
-    uint8_t raddrBuf[std::max(sizeof(sockaddr_in), sizeof(sockaddr_in6))];
-    sockaddr* raddr = nullptr;
-    socklen_t raddrLen = 0;
+    uint8_t raddr[std::max(sizeof(sockaddr_in), sizeof(sockaddr_in6))];
+    msghdr msg{};
     if (endpointId != 0) {
-      if (m_endpoints.decode(endpointId, raddrBuf + p.ipOff,
-                             reinterpret_cast<in_port_t*>(raddrBuf + p.portOff)) != p.ipLen) {
+      if (m_endpoints.decode(endpointId, raddr + p.ipOff,
+                             reinterpret_cast<in_port_t*>(raddr + p.portOff)) != p.ipLen) {
         return false;
       }
-      raddr = reinterpret_cast<sockaddr*>(raddrBuf);
-      raddr->sa_family = m_af;
-      raddrLen = p.nameLen;
+      reinterpret_cast<sockaddr*>(raddr)->sa_family = m_af;
+      msg.msg_name = raddr;
+      msg.msg_namelen = p.nameLen;
     }
 
-    ssize_t sentLen = sendto(m_fd, pkt, pktLen, 0, raddr, raddrLen);
+    iovec vec[MaxIovCnt::value];
+    for (size_t i = 0; i < iovcnt; ++i) {
+      vec[i].iov_base = const_cast<uint8_t*>(iov[i].base);
+      vec[i].iov_len = iov[i].len;
+    }
+    msg.msg_iov = vec;
+    msg.msg_iovlen = iovcnt;
+
+    ssize_t sentLen = sendmsg(m_fd, &msg, 0);
     if (sentLen >= 0) {
       return true;
     }
@@ -165,6 +185,9 @@ private:
   }
 
 private:
+  /** @brief Maximum number of buffers gathered by sendmsg; more are copied. */
+  using MaxIovCnt = std::integral_constant<size_t, 8>;
+
   struct AddressFamilyParams {
     socklen_t nameLen;
     ptrdiff_t ipOff;
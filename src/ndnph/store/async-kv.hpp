@@ -0,0 +1,216 @@
+#ifndef NDNPH_STORE_ASYNC_KV_HPP
+#define NDNPH_STORE_ASYNC_KV_HPP
+
+#include "../face/packet-handler.hpp"
+#include "../port/queue/port.hpp"
+#include "kv.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief Asynchronous front-end of KvStore.
+ * @tparam queueCap maximum number of outstanding operations.
+ * @tparam keyCap maximum key length plus one.
+ *
+ * Operations are queued on the Face thread, and performed by a worker that blocks on the
+ * filesystem. The application should invoke @c work() repeatedly in a dedicated thread.
+ * Completions are handed back through a @c port::SafeQueue , and their callbacks are invoked
+ * during @c Face::loop() , so that a packet handler can defer its reply until a value is read,
+ * instead of stalling the packet loop.
+ *
+ * While this front-end is in use, the KvStore must not be accessed from other threads.
+ * The worker thread must be stopped before this front-end is destructed.
+ */
+template<size_t queueCap = 16, size_t keyCap = 64>
+class BasicAsyncKvStore : public PacketHandler {
+public:
+  /**
+   * @brief Callback upon completion of @c get() .
+   * @param value retrieved value, which is empty upon error. It is valid only during the callback.
+   */
+  using GetCallback = void (*)(void* ctx, const char* key, tlv::Value value);
+
+  /**
+   * @brief Callback upon completion of @c set() or @c del() .
+   * @param ok whether success.
+   */
+  using SetCallback = void (*)(void* ctx, const char* key, bool ok);
+
+  /**
+   * @brief Constructor.
+   * @param face face whose loop drains completions.
+   * @param store underlying KvStore.
+   * @param maxValueSize maximum size of a retrieved value.
+   */
+  explicit BasicAsyncKvStore(Face& face, KvStore& store, size_t maxValueSize = 4096)
+    : PacketHandler(face)
+    , m_store(store)
+    , m_region(maxValueSize) {}
+
+  ~BasicAsyncKvStore() override {
+    for (bool ok = true; ok;) {
+      Op op;
+      std::tie(op, ok) = m_requestQ.pop();
+      delete[] op.value;
+    }
+    for (bool ok = true; ok;) {
+      Op op;
+      std::tie(op, ok) = m_completionQ.pop();
+      delete[] op.value;
+    }
+  }
+
+  /**
+   * @brief Retrieve a value asynchronously.
+   * @return whether the operation is queued.
+   */
+  bool get(const char* key, GetCallback cb, void* ctx) {
+    Op op;
+    op.type = OpGet;
+    op.getCb = cb;
+    op.ctx = ctx;
+    return submit(op, key);
+  }
+
+  /**
+   * @brief Store a value asynchronously.
+   * @param value the value, which is copied.
+   * @return whether the operation is queued.
+   */
+  bool set(const char* key, tlv::Value value, SetCallback cb = nullptr, void* ctx = nullptr) {
+    Op op;
+    op.type = OpSet;
+    op.value = new uint8_t[value.size()];
+    op.size = value.size();
+    std::copy(value.begin(), value.end(), op.value);
+    op.setCb = cb;
+    op.ctx = ctx;
+    if (!submit(op, key)) {
+      delete[] op.value;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Delete a key asynchronously.
+   * @return whether the operation is queued.
+   */
+  bool del(const char* key, SetCallback cb = nullptr, void* ctx = nullptr) {
+    Op op;
+    op.type = OpDel;
+    op.setCb = cb;
+    op.ctx = ctx;
+    return submit(op, key);
+  }
+
+  /**
+   * @brief Perform one queued operation.
+   * @return whether an operation has been performed.
+   *
+   * This should be invoked repeatedly in a dedicated thread.
+   * It must not be invoked concurrently.
+   */
+  bool work() {
+    Op op;
+    bool ok = false;
+    std::tie(op, ok) = m_requestQ.pop();
+    if (!ok) {
+      return false;
+    }
+
+    switch (op.type) {
+      case OpGet: {
+        m_region.reset();
+        tlv::Value value = m_store.get(op.key, m_region);
+        op.ok = value.size() > 0;
+        if (op.ok) {
+          op.value = new uint8_t[value.size()];
+          op.size = value.size();
+          std::copy(value.begin(), value.end(), op.value);
+        }
+        break;
+      }
+      case OpSet:
+        op.ok = m_store.set(op.key, tlv::Value(op.value, op.size));
+        break;
+      case OpDel:
+        op.ok = m_store.del(op.key);
+        break;
+    }
+
+    ok = m_completionQ.push(op);
+    NDNPH_ASSERT(ok);
+    return true;
+  }
+
+  /** @brief Count operations submitted but not yet completed on the Face thread. */
+  size_t countOutstanding() const {
+    return m_nOutstanding;
+  }
+
+private:
+  enum OpType : uint8_t {
+    OpGet,
+    OpSet,
+    OpDel,
+  };
+
+  struct Op {
+    OpType type = OpGet;
+    bool ok = false;
+    char key[keyCap];
+    uint8_t* value = nullptr;
+    size_t size = 0;
+    GetCallback getCb = nullptr;
+    SetCallback setCb = nullptr;
+    void* ctx = nullptr;
+  };
+
+  bool submit(Op& op, const char* key) {
+    size_t keyLen = key == nullptr ? keyCap : strlen(key);
+    if (keyLen >= keyCap || m_nOutstanding >= queueCap) {
+      return false;
+    }
+    std::copy_n(key, keyLen + 1, op.key);
+    if (!m_requestQ.push(op)) {
+      return false;
+    }
+    ++m_nOutstanding;
+    return true;
+  }
+
+  void loop() final {
+    for (;;) {
+      Op op;
+      bool ok = false;
+      std::tie(op, ok) = m_completionQ.pop();
+      if (!ok) {
+        break;
+      }
+      --m_nOutstanding;
+
+      if (op.type == OpGet) {
+        if (op.getCb != nullptr) {
+          op.getCb(op.ctx, op.key, tlv::Value(op.value, op.size));
+        }
+      } else if (op.setCb != nullptr) {
+        op.setCb(op.ctx, op.key, op.ok);
+      }
+      delete[] op.value;
+    }
+  }
+
+private:
+  KvStore& m_store;
+  DynamicRegion m_region;
+  port::SafeQueue<Op, queueCap> m_requestQ;
+  port::SafeQueue<Op, queueCap> m_completionQ;
+  size_t m_nOutstanding = 0;
+};
+
+using AsyncKvStore = BasicAsyncKvStore<>;
+
+} // namespace ndnph
+
+#endif // NDNPH_STORE_ASYNC_KV_HPP
@@ -0,0 +1,357 @@
+#ifndef NDNPH_STORE_CONTENT_STORE_HPP
+#define NDNPH_STORE_CONTENT_STORE_HPP
+
+#include "../face/packet-handler.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief In-memory cache of Data packets.
+ * @tparam maxEntries maximum number of cached packets.
+ * @tparam nameCap maximum Name TLV-VALUE length of a cached packet.
+ * @tparam slabSize size of each slab in the arena.
+ *
+ * Encoded Data packets are stored in an arena of fixed-size slabs; each packet occupies a chain
+ * of slabs, so that the arena does not fragment. Names are indexed by a hash table for exact
+ * lookup, and by an array sorted in TLV-VALUE octet order for CanBePrefix lookup; in this order,
+ * all names under a prefix are adjacent. When the arena or the entry table is full, least recently
+ * used packets are evicted.
+ *
+ * This should be added to a Face at high priority. Incoming Data packets are cached and passed
+ * on to other handlers. Incoming Interests are answered from the cache if possible. A producer
+ * on the same Face can cache its own Data packets with @c insert() .
+ * @note Interests with implicit digest component are not answered from the cache.
+ */
+template<int maxEntries = 64, size_t nameCap = 256, size_t slabSize = 256>
+class BasicContentStore : public PacketHandler {
+public:
+  /**
+   * @brief Constructor.
+   * @param face face for communication.
+   * @param capacity arena capacity in octets.
+   * @param maxWireSize maximum encoded size of a cached packet.
+   * @param prio packet handler priority.
+   */
+  explicit BasicContentStore(Face& face, size_t capacity = 65536, size_t maxWireSize = 8800,
+                             int8_t prio = std::numeric_limits<int8_t>::min())
+    : PacketHandler(face, prio)
+    , m_nSlabs(std::max<size_t>(capacity / slabSize, 1))
+    , m_arena(new uint8_t[m_nSlabs * slabSize])
+    , m_slabNext(new int32_t[m_nSlabs])
+    , m_scratch(maxWireSize + lp::EncodableBase::L3MaxSize::value) {
+    for (size_t i = 0; i < m_nSlabs; ++i) {
+      m_slabNext[i] = i + 1 < m_nSlabs ? i + 1 : -1;
+    }
+    m_slabFree = 0;
+    m_nSlabsFree = m_nSlabs;
+
+    std::fill_n(m_buckets, NBuckets, -1);
+    for (int i = 0; i < maxEntries; ++i) {
+      m_entries[i].hashNext = i + 1 < maxEntries ? i + 1 : -1;
+    }
+    m_entryFree = 0;
+  }
+
+  /**
+   * @brief Insert a Data packet.
+   * @param data decoded Data packet.
+   * @return whether success.
+   *
+   * If a packet of the same name exists, it is replaced.
+   */
+  bool insert(Data data) {
+    const Name& name = data.getName();
+    if (!data || name.length() > nameCap) {
+      return false;
+    }
+
+    ScopedEncoder encoder(m_scratch);
+    if (!encoder.prepend(data)) {
+      return false;
+    }
+    size_t nSlabs = divCeil(encoder.size(), slabSize);
+    if (nSlabs > m_nSlabs) {
+      return false;
+    }
+
+    uint32_t h = name.getPrefixHash();
+    int existing = findExact(h, name.value(), name.length());
+    if (existing >= 0) {
+      erase(existing);
+    }
+    while (m_entryFree < 0 || m_nSlabsFree < nSlabs) {
+      erase(m_lruTail);
+      ++m_cnt.nEvictions;
+    }
+
+    int i = m_entryFree;
+    Entry& entry = m_entries[i];
+    m_entryFree = entry.hashNext;
+    entry.hash = h;
+    entry.nameLength = name.length();
+    std::copy_n(name.value(), name.length(), entry.name);
+    entry.arrival = port::Clock::now();
+    entry.freshnessPeriod = data.getFreshnessPeriod();
+    entry.wireSize = encoder.size();
+    entry.firstSlab = writeSlabs(encoder.begin(), encoder.size());
+    entry.used = true;
+
+    int16_t& head = m_buckets[h % NBuckets];
+    entry.hashNext = head;
+    head = i;
+    insertSorted(i);
+    lruPushFront(i);
+    ++m_size;
+    ++m_cnt.nInserts;
+    return true;
+  }
+
+  /** @brief Remove all packets. */
+  void clear() {
+    while (m_lruTail >= 0) {
+      erase(m_lruTail);
+    }
+  }
+
+  /** @brief Return number of cached packets. */
+  int size() const {
+    return m_size;
+  }
+
+  struct Counters {
+    uint32_t nHits = 0;
+    uint32_t nMisses = 0;
+    uint32_t nInserts = 0;
+    uint32_t nEvictions = 0;
+  };
+
+  Counters readCounters() const {
+    return m_cnt;
+  }
+
+private:
+  struct Entry {
+    port::Clock::Time arrival;
+    uint32_t freshnessPeriod = 0;
+    uint32_t hash = 0;
+    uint32_t wireSize = 0;
+    int32_t firstSlab = -1;
+    int16_t hashNext = -1;
+    int16_t lruPrev = -1;
+    int16_t lruNext = -1;
+    uint16_t nameLength = 0;
+    bool used = false;
+    uint8_t name[nameCap];
+  };
+
+  /** @brief Encodable that copies a packet from its slab chain. */
+  class SlabWire {
+  public:
+    explicit SlabWire(const BasicContentStore& cs, const Entry& entry)
+      : m_cs(cs)
+      , m_entry(entry) {}
+
+    void encodeTo(Encoder& encoder) const {
+      uint8_t* room = encoder.prependRoom(m_entry.wireSize);
+      if (room == nullptr) {
+        return;
+      }
+      size_t remain = m_entry.wireSize;
+      for (int32_t slab = m_entry.firstSlab; remain > 0; slab = m_cs.m_slabNext[slab]) {
+        size_t len = std::min(remain, slabSize);
+        std::copy_n(&m_cs.m_arena[slab * slabSize], len, room);
+        room += len;
+        remain -= len;
+      }
+    }
+
+  private:
+    const BasicContentStore& m_cs;
+    const Entry& m_entry;
+  };
+
+  /**
+   * @brief Find a cached packet that satisfies an Interest.
+   * @return entry index, or -1 if not found.
+   */
+  int find(const Interest& interest) {
+    const Name& name = interest.getName();
+    if (name.size() > 0 && name[-1].is<convention::ImplicitDigest>()) {
+      return -1;
+    }
+    auto now = port::Clock::now();
+
+    if (!interest.getCanBePrefix()) {
+      int i = findExact(name.getPrefixHash(), name.value(), name.length());
+      return i >= 0 && isUsable(m_entries[i], interest, now) ? i : -1;
+    }
+
+    for (int pos = lowerBound(name.value(), name.length()); pos < m_size; ++pos) {
+      const Entry& entry = m_entries[m_sorted[pos]];
+      if (entry.nameLength < name.length() ||
+          !std::equal(name.value(), name.value() + name.length(), entry.name)) {
+        break;
+      }
+      if (isUsable(entry, interest, now)) {
+        return m_sorted[pos];
+      }
+    }
+    return -1;
+  }
+
+  bool processInterest(Interest interest) final {
+    int i = find(interest);
+    if (i < 0) {
+      ++m_cnt.nMisses;
+      return false;
+    }
+    ++m_cnt.nHits;
+    lruErase(i);
+    lruPushFront(i);
+    reply(m_scratch, SlabWire(*this, m_entries[i]));
+    return true;
+  }
+
+  bool processData(Data data) final {
+    insert(data);
+    return false;
+  }
+
+  static bool isUsable(const Entry& entry, const Interest& interest, port::Clock::Time now) {
+    if (!interest.getMustBeFresh()) {
+      return true;
+    }
+    int age = port::Clock::sub(now, entry.arrival);
+    return age >= 0 && static_cast<uint32_t>(age) < entry.freshnessPeriod;
+  }
+
+  int findExact(uint32_t h, const uint8_t* name, size_t nameLength) const {
+    for (int i = m_buckets[h % NBuckets]; i >= 0; i = m_entries[i].hashNext) {
+      const Entry& entry = m_entries[i];
+      if (entry.hash == h && entry.nameLength == nameLength &&
+          std::equal(name, name + nameLength, entry.name)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /** @brief Find first position in sorted array whose name is not less than given name. */
+  int lowerBound(const uint8_t* name, size_t nameLength) const {
+    auto it = std::lower_bound(&m_sorted[0], &m_sorted[m_size], 0, [&](int16_t i, int) {
+      const Entry& entry = m_entries[i];
+      return std::lexicographical_compare(entry.name, entry.name + entry.nameLength, name,
+                                          name + nameLength);
+    });
+    return it - &m_sorted[0];
+  }
+
+  void insertSorted(int i) {
+    const Entry& entry = m_entries[i];
+    int pos = lowerBound(entry.name, entry.nameLength);
+    std::copy_backward(&m_sorted[pos], &m_sorted[m_size], &m_sorted[m_size + 1]);
+    m_sorted[pos] = i;
+  }
+
+  void eraseSorted(int i) {
+    const Entry& entry = m_entries[i];
+    int pos = lowerBound(entry.name, entry.nameLength);
+    for (; m_sorted[pos] != i; ++pos) {
+    }
+    std::copy(&m_sorted[pos + 1], &m_sorted[m_size], &m_sorted[pos]);
+  }
+
+  int32_t writeSlabs(const uint8_t* wire, size_t size) {
+    int32_t first = m_slabFree;
+    int32_t last = -1;
+    for (size_t offset = 0; offset < size; offset += slabSize) {
+      last = m_slabFree;
+      m_slabFree = m_slabNext[last];
+      --m_nSlabsFree;
+      std::copy_n(wire + offset, std::min(size - offset, slabSize), &m_arena[last * slabSize]);
+    }
+    m_slabNext[last] = -1;
+    return first;
+  }
+
+  void erase(int i) {
+    Entry& entry = m_entries[i];
+    for (int16_t* cur = &m_buckets[entry.hash % NBuckets]; *cur >= 0;
+         cur = &m_entries[*cur].hashNext) {
+      if (*cur == i) {
+        *cur = entry.hashNext;
+        break;
+      }
+    }
+    eraseSorted(i);
+    lruErase(i);
+    --m_size;
+
+    int32_t slab = entry.firstSlab;
+    while (slab >= 0) {
+      int32_t next = m_slabNext[slab];
+      m_slabNext[slab] = m_slabFree;
+      m_slabFree = slab;
+      ++m_nSlabsFree;
+      slab = next;
+    }
+
+    entry.used = false;
+    entry.firstSlab = -1;
+    entry.hashNext = m_entryFree;
+    m_entryFree = i;
+  }
+
+  void lruPushFront(int i) {
+    Entry& entry = m_entries[i];
+    entry.lruPrev = -1;
+    entry.lruNext = m_lruHead;
+    if (m_lruHead >= 0) {
+      m_entries[m_lruHead].lruPrev = i;
+    } else {
+      m_lruTail = i;
+    }
+    m_lruHead = i;
+  }
+
+  void lruErase(int i) {
+    Entry& entry = m_entries[i];
+    if (entry.lruPrev >= 0) {
+      m_entries[entry.lruPrev].lruNext = entry.lruNext;
+    } else {
+      m_lruHead = entry.lruNext;
+    }
+    if (entry.lruNext >= 0) {
+      m_entries[entry.lruNext].lruPrev = entry.lruPrev;
+    } else {
+      m_lruTail = entry.lruPrev;
+    }
+  }
+
+private:
+  static constexpr int NBuckets = maxEntries * 2;
+
+  size_t m_nSlabs;
+  std::unique_ptr<uint8_t[]> m_arena;
+  std::unique_ptr<int32_t[]> m_slabNext;
+  int32_t m_slabFree = -1;
+  size_t m_nSlabsFree = 0;
+  DynamicRegion m_scratch;
+
+  Entry m_entries[maxEntries];
+  int16_t m_buckets[NBuckets];
+  int16_t m_sorted[maxEntries];
+  int m_entryFree = -1;
+  int m_size = 0;
+  int m_lruHead = -1;
+  int m_lruTail = -1;
+  Counters m_cnt;
+
+  static_assert(maxEntries >= 1 && maxEntries <= std::numeric_limits<int16_t>::max(), "");
+};
+
+using ContentStore = BasicContentStore<>;
+
+} // namespace ndnph
+
+#endif // NDNPH_STORE_CONTENT_STORE_HPP
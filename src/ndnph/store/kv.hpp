@@ -56,6 +56,36 @@ public:
     return tlv::Value(buf, size);
   }
 
+  /**
+   * @brief Retrieve a value without copying.
+   * @param key non-empty key, can only contain digits, lower-case letters, and '_'.
+   * @return the value, pointing into a read-only memory mapping of the file.
+   *         Empty value upon error, or if the FileStore backend does not support memory mapping.
+   *
+   * The mapping is cached and reused by subsequent calls with the same key. The returned value
+   * remains valid until @c set() or @c del() of the same key, @c commitBatch() , or until this
+   * KvStore is destroyed.
+   */
+  tlv::Value getMapped(const char* key) {
+    if (m_fs == nullptr || !checkKey(key)) {
+      return tlv::Value();
+    }
+    Mapping* mapping = m_mappings.get();
+    for (; mapping != nullptr && strcmp(mapping->key.get(), key) != 0;
+         mapping = mapping->next.get()) {
+    }
+    if (mapping == nullptr) {
+      std::unique_ptr<Mapping> created(new Mapping(key));
+      if (!m_fs->map(key, created->mapping)) {
+        return tlv::Value();
+      }
+      created->next = std::move(m_mappings);
+      m_mappings = std::move(created);
+      mapping = m_mappings.get();
+    }
+    return tlv::Value(mapping->mapping.data(), mapping->mapping.size());
+  }
+
   /**
    * @brief Store a value.
    * @param key non-empty key, can only contain digits, lower-case letters, and '_'.
@@ -70,6 +100,7 @@ public:
     if (m_fs == nullptr || !checkKey(key)) {
       return false;
     }
+    unmap(key);
     return m_fs->write(key, value.begin(), value.size());
   }
 
@@ -82,10 +113,53 @@ public:
     if (m_fs == nullptr || !checkKey(key)) {
       return false;
     }
+    unmap(key);
     return m_fs->unlink(key);
   }
 
+  /**
+   * @brief Start a batch of writes.
+   *
+   * Values stored with @c set() and keys deleted with @c del() take effect upon
+   * @c commitBatch() , and are flushed to storage together.
+   */
+  void beginBatch() {
+    if (m_fs != nullptr) {
+      m_fs->beginBatch();
+    }
+  }
+
+  /**
+   * @brief Commit a batch of writes.
+   * @return whether success.
+   */
+  bool commitBatch() {
+    m_mappings.reset();
+    return m_fs != nullptr && m_fs->commitBatch();
+  }
+
 private:
+  struct Mapping {
+    explicit Mapping(const char* key)
+      : key(new char[strlen(key) + 1]) {
+      strcpy(this->key.get(), key);
+    }
+
+    std::unique_ptr<char[]> key;
+    port::FileMapping mapping;
+    std::unique_ptr<Mapping> next;
+  };
+
+  /** @brief Invalidate cached mapping of @p key . */
+  void unmap(const char* key) {
+    for (std::unique_ptr<Mapping>* cur = &m_mappings; *cur != nullptr; cur = &(*cur)->next) {
+      if (strcmp((*cur)->key.get(), key) == 0) {
+        *cur = std::move((*cur)->next);
+        return;
+      }
+    }
+  }
+
   static bool checkKey(const char* key) {
     size_t keyLen = 0;
     if (key == nullptr || (keyLen = strlen(key)) == 0) {
@@ -103,6 +177,7 @@ private:
 private:
   std::unique_ptr<port::FileStore> m_ownFs;
   port::FileStore* m_fs = nullptr;
+  std::unique_ptr<Mapping> m_mappings;
 };
 
 } // namespace ndnph
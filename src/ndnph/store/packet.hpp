@@ -21,16 +21,18 @@ public:
    * @return the packet. Empty packet upon error.
    */
   T get(const char* key, Region& region) {
-    tlv::Value wire = KvStore::get(key, region);
-    if (wire.size() == 0) {
-      return T();
-    }
+    return decodePacket(KvStore::get(key, region), region);
+  }
 
-    T packet = region.create<T>();
-    if (!packet || !wire.makeDecoder().decode(packet)) {
-      return T();
-    }
-    return packet;
+  /**
+   * @brief Retrieve a packet without copying its encoding.
+   * @param key non-empty key.
+   * @param region where to allocate memory for the packet object.
+   * @return the packet, which references a memory mapping as described in
+   *         @c KvStore::getMapped() . Empty packet upon error.
+   */
+  T getMapped(const char* key, Region& region) {
+    return decodePacket(KvStore::getMapped(key), region);
   }
 
   /**
@@ -48,6 +50,19 @@ public:
     }
     return KvStore::set(key, tlv::Value(encoder));
   }
+
+private:
+  static T decodePacket(tlv::Value wire, Region& region) {
+    if (wire.size() == 0) {
+      return T();
+    }
+
+    T packet = region.create<T>();
+    if (!packet || !wire.makeDecoder().decode(packet)) {
+      return T();
+    }
+    return packet;
+  }
 };
 
 } // namespace ndnph
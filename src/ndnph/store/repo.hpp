@@ -0,0 +1,449 @@
+#ifndef NDNPH_STORE_REPO_HPP
+#define NDNPH_STORE_REPO_HPP
+
+#include "../face/packet-handler.hpp"
+#include "../port/fs/port.hpp"
+
+namespace ndnph {
+
+/**
+ * @brief File based Data packet repository.
+ *
+ * Data packets are appended to a log file. Each record has an 8-octet header, containing
+ * payload length and an FNV-1a checksum of the payload, followed by the payload. The payload is
+ * either an encoded Data packet, or a Name TLV that marks the deletion of an earlier packet.
+ *
+ * An in-memory hash table maps each name to its latest record offset, so that retrieving a
+ * packet needs one read from the log. The index is rebuilt by scanning the log when it is opened;
+ * a torn or corrupted record at the tail, left over by a crash, is truncated, while a corrupted or
+ * oversized record elsewhere fails the open. @c compact() rewrites live records into a temporary
+ * file, which then atomically replaces the log.
+ */
+class DataRepo {
+public:
+  /**
+   * @brief Constructor.
+   * @param maxEntries maximum number of stored packets.
+   * @param maxWireSize maximum encoded size of a stored packet.
+   */
+  explicit DataRepo(size_t maxEntries = 1024, size_t maxWireSize = 8800)
+    : m_maxEntries(maxEntries)
+    , m_maxWireSize(maxWireSize)
+    , m_mask(computeMask(maxEntries))
+    , m_slots(new Slot[m_mask + 1])
+    , m_scratch(2 * (HeaderSize::value + maxWireSize)) {}
+
+  /**
+   * @brief Open the log file and rebuild the index.
+   * @tparam Arg arguments passed to @c port::AppendFile::open() function.
+   * @return whether success.
+   */
+  template<typename... Arg>
+  bool open(Arg&&... arg) {
+    clearIndex();
+    return m_file.open(std::forward<Arg>(arg)...) && recover();
+  }
+
+  /**
+   * @brief Store a Data packet.
+   * @param data decoded or signed Data packet.
+   * @return whether success.
+   *
+   * If a packet of the same name exists, it is replaced.
+   */
+  template<typename Encodable>
+  bool insert(const Encodable& data) {
+    m_scratch.reset();
+    Encoder encoder(m_scratch);
+    Decoder::Tlv nameTlv;
+    if (!encoder.prepend(data) || encoder.size() > m_maxWireSize ||
+        !extractName(encoder.begin(), encoder.size(), false, nameTlv)) {
+      return false;
+    }
+    size_t payloadSize = encoder.size();
+    writeHeader(encoder.prependRoom(HeaderSize::value), payloadSize, false);
+    encoder.trim();
+    if (!encoder) {
+      return false;
+    }
+
+    uint32_t h = hashName(nameTlv);
+    ssize_t pos = probe(h, nameTlv);
+    if (pos < 0 && m_size >= m_maxEntries) {
+      return false;
+    }
+    size_t offset = m_file.size();
+    if (!m_file.append(encoder.begin(), encoder.size())) {
+      return false;
+    }
+
+    if (pos >= 0) {
+      m_deadBytes += HeaderSize::value + m_slots[pos].size;
+    } else {
+      pos = ~pos;
+      ++m_size;
+    }
+    m_slots[pos] = Slot{offset, h, static_cast<uint32_t>(payloadSize)};
+    return true;
+  }
+
+  /**
+   * @brief Delete a Data packet.
+   * @return whether success; deleting a non-existent packet is considered successful.
+   */
+  bool erase(const Name& name) {
+    m_scratch.reset();
+    Encoder encoder(m_scratch);
+    if (!encoder.prepend(name)) {
+      return false;
+    }
+    size_t payloadSize = encoder.size();
+    writeHeader(encoder.prependRoom(HeaderSize::value), payloadSize, true);
+    encoder.trim();
+    Decoder::Tlv nameTlv;
+    if (!encoder ||
+        !extractName(encoder.begin() + HeaderSize::value, payloadSize, true, nameTlv)) {
+      return false;
+    }
+
+    ssize_t pos = probe(hashName(nameTlv), nameTlv);
+    if (pos < 0) {
+      return true;
+    }
+    if (!m_file.append(encoder.begin(), encoder.size())) {
+      return false;
+    }
+    m_deadBytes += 2 * HeaderSize::value + m_slots[pos].size + payloadSize;
+    removeSlot(pos);
+    return true;
+  }
+
+  /**
+   * @brief Retrieve an encoded Data packet.
+   * @param name Data name.
+   * @param region where to allocate memory.
+   * @return encoded Data packet. Empty value if not found.
+   */
+  tlv::Value getWire(const Name& name, Region& region) {
+    Decoder::Tlv nameTlv;
+    nameTlv.type = TT::Name;
+    nameTlv.value = name.value();
+    nameTlv.length = name.length();
+    tlv::Value wire;
+    probe(hashName(nameTlv), nameTlv, &region, &wire);
+    return wire;
+  }
+
+  /**
+   * @brief Retrieve a Data packet.
+   * @param name Data name.
+   * @param region where to allocate memory.
+   * @return the packet. Empty packet if not found.
+   */
+  Data get(const Name& name, Region& region) {
+    tlv::Value wire = getWire(name, region);
+    Data data = region.create<Data>();
+    if (wire.size() == 0 || !data || !wire.makeDecoder().decode(data)) {
+      return Data();
+    }
+    return data;
+  }
+
+  /**
+   * @brief Rewrite the log to contain only live records.
+   * @return whether success; upon failure, the log is unchanged.
+   */
+  bool compact() {
+    port::AppendFile temp;
+    if (!temp.openTemp(m_file)) {
+      return false;
+    }
+    for (size_t i = 0; i <= m_mask; ++i) {
+      const Slot& slot = m_slots[i];
+      if (slot.size == 0) {
+        continue;
+      }
+      m_scratch.reset();
+      size_t size = HeaderSize::value + slot.size;
+      uint8_t* buf = m_scratch.alloc(size);
+      if (buf == nullptr || m_file.read(slot.offset, buf, size) != static_cast<int>(size) ||
+          !temp.append(buf, size)) {
+        return false;
+      }
+    }
+    if (!temp.commit(m_file)) {
+      return false;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i <= m_mask; ++i) {
+      Slot& slot = m_slots[i];
+      if (slot.size != 0) {
+        slot.offset = offset;
+        offset += HeaderSize::value + slot.size;
+      }
+    }
+    m_deadBytes = 0;
+    return true;
+  }
+
+  /**
+   * @brief Flush the log to storage device.
+   * @return whether success.
+   */
+  bool sync() {
+    return m_file.sync();
+  }
+
+  /** @brief Return number of stored packets. */
+  size_t size() const {
+    return m_size;
+  }
+
+  /** @brief Return log file size. */
+  size_t logSize() const {
+    return m_file.size();
+  }
+
+  /** @brief Return log file octets that would be reclaimed by @c compact() . */
+  size_t deadBytes() const {
+    return m_deadBytes;
+  }
+
+  /** @brief Return maximum encoded size of a stored packet. */
+  size_t getMaxWireSize() const {
+    return m_maxWireSize;
+  }
+
+private:
+  using HeaderSize = std::integral_constant<size_t, 8>;
+  using TombstoneFlag = std::integral_constant<uint32_t, 0x80000000>;
+
+  struct Slot {
+    size_t offset;
+    uint32_t hash;
+    uint32_t size; ///< payload length; zero indicates empty slot
+  };
+
+  static size_t computeMask(size_t maxEntries) {
+    size_t nSlots = 2;
+    while (nSlots < 2 * maxEntries) {
+      nSlots <<= 1;
+    }
+    return nSlots - 1;
+  }
+
+  static uint32_t hashName(const Decoder::Tlv& nameTlv) {
+    return detail::fnv1a(nameTlv.value, nameTlv.length);
+  }
+
+  /** @brief Write record header in @p room , which is followed by the payload. */
+  static void writeHeader(uint8_t* room, size_t size, bool isTombstone) {
+    if (room == nullptr) {
+      return;
+    }
+    uint32_t word = static_cast<uint32_t>(size) | (isTombstone ? TombstoneFlag::value : 0);
+    uint32_t checksum = detail::fnv1a(room + HeaderSize::value, size);
+    for (int i = 0; i < 4; ++i) {
+      room[i] = word >> (24 - 8 * i);
+      room[4 + i] = checksum >> (24 - 8 * i);
+    }
+  }
+
+  static uint32_t readWord(const uint8_t* room) {
+    return (static_cast<uint32_t>(room[0]) << 24) | (static_cast<uint32_t>(room[1]) << 16) |
+           (static_cast<uint32_t>(room[2]) << 8) | room[3];
+  }
+
+  /**
+   * @brief Locate Name TLV in a record payload.
+   * @param payload record payload.
+   * @param size payload length.
+   * @param isTombstone whether payload is a Name TLV rather than a Data packet.
+   * @param[out] nameTlv Name TLV.
+   */
+  static bool extractName(const uint8_t* payload, size_t size, bool isTombstone,
+                          Decoder::Tlv& nameTlv) {
+    if (!Decoder::readTlv(nameTlv, payload, payload + size) || nameTlv.size != size) {
+      return false;
+    }
+    if (!isTombstone) {
+      if (nameTlv.type != TT::Data ||
+          !Decoder::readTlv(nameTlv, nameTlv.value, nameTlv.value + nameTlv.length)) {
+        return false;
+      }
+    }
+    return nameTlv.type == TT::Name;
+  }
+
+  /**
+   * @brief Find slot of a name.
+   * @param h name hash.
+   * @param nameTlv Name TLV.
+   * @param region if not nullptr, where to keep the payload of a found record.
+   * @param[out] payload payload of a found record.
+   * @return slot position if found; otherwise, bitwise NOT of an empty slot position.
+   */
+  ssize_t probe(uint32_t h, const Decoder::Tlv& nameTlv, Region* region = nullptr,
+                tlv::Value* payload = nullptr) {
+    Region& r = region == nullptr ? m_scratch : *region;
+    for (size_t pos = h & m_mask;; pos = (pos + 1) & m_mask) {
+      const Slot& slot = m_slots[pos];
+      if (slot.size == 0) {
+        return ~static_cast<ssize_t>(pos);
+      }
+      if (slot.hash != h) {
+        continue;
+      }
+
+      uint8_t* buf = r.alloc(slot.size);
+      Decoder::Tlv found;
+      if (buf != nullptr && readPayload(slot, buf) && extractName(buf, slot.size, false, found) &&
+          found.length == nameTlv.length &&
+          std::equal(found.value, found.value + found.length, nameTlv.value)) {
+        if (region != nullptr) {
+          *payload = tlv::Value(buf, slot.size);
+        } else {
+          r.free(buf, slot.size);
+        }
+        return pos;
+      }
+      r.free(buf, slot.size);
+    }
+  }
+
+  bool readPayload(const Slot& slot, uint8_t* buf) {
+    return m_file.read(slot.offset + HeaderSize::value, buf, slot.size) ==
+           static_cast<int>(slot.size);
+  }
+
+  /** @brief Remove a slot with backward shift deletion. */
+  void removeSlot(size_t pos) {
+    for (size_t next = (pos + 1) & m_mask; m_slots[next].size != 0; next = (next + 1) & m_mask) {
+      size_t home = m_slots[next].hash & m_mask;
+      // move next into pos, unless its home lies cyclically within (pos, next]
+      bool keep = pos <= next ? (pos < home && home <= next) : (pos < home || home <= next);
+      if (!keep) {
+        m_slots[pos] = m_slots[next];
+        pos = next;
+      }
+    }
+    m_slots[pos].size = 0;
+    --m_size;
+  }
+
+  void clearIndex() {
+    std::fill_n(&m_slots[0], m_mask + 1, Slot{0, 0, 0});
+    m_size = 0;
+    m_deadBytes = 0;
+  }
+
+  /**
+   * @brief Scan the log to rebuild the index, and truncate a torn tail.
+   * @return whether success.
+   *
+   * Only a record that runs past the end of file, or an invalid last record, is considered torn.
+   * Any other invalid record, or a record exceeding maxWireSize, fails the scan and leaves the
+   * file unchanged.
+   */
+  bool recover() {
+    size_t offset = 0;
+    uint8_t header[HeaderSize::value];
+    while (offset + HeaderSize::value <= m_file.size()) {
+      if (m_file.read(offset, header, sizeof(header)) != static_cast<int>(sizeof(header))) {
+        return false;
+      }
+      uint32_t word = readWord(header);
+      bool isTombstone = (word & TombstoneFlag::value) != 0;
+      size_t size = word & ~TombstoneFlag::value;
+      size_t end = offset + HeaderSize::value + size;
+      if (end > m_file.size()) { // torn tail
+        break;
+      }
+      if (size > m_maxWireSize) {
+        return false;
+      }
+
+      m_scratch.reset();
+      uint8_t* payload = m_scratch.alloc(size);
+      if (payload == nullptr ||
+          m_file.read(offset + HeaderSize::value, payload, size) != static_cast<int>(size)) {
+        return false;
+      }
+      Decoder::Tlv nameTlv;
+      if (size == 0 || detail::fnv1a(payload, size) != readWord(&header[4]) ||
+          !extractName(payload, size, isTombstone, nameTlv)) {
+        if (end == m_file.size()) { // corrupted last record
+          break;
+        }
+        return false;
+      }
+
+      uint32_t h = hashName(nameTlv);
+      ssize_t pos = probe(h, nameTlv);
+      if (pos >= 0) {
+        m_deadBytes += HeaderSize::value + m_slots[pos].size;
+        if (isTombstone) {
+          m_deadBytes += HeaderSize::value + size;
+          removeSlot(pos);
+        } else {
+          m_slots[pos] = Slot{offset, h, static_cast<uint32_t>(size)};
+        }
+      } else if (isTombstone) {
+        m_deadBytes += HeaderSize::value + size;
+      } else if (m_size < m_maxEntries) {
+        m_slots[~pos] = Slot{offset, h, static_cast<uint32_t>(size)};
+        ++m_size;
+      } else {
+        return false;
+      }
+      offset += HeaderSize::value + size;
+    }
+    return offset == m_file.size() || m_file.truncate(offset);
+  }
+
+private:
+  port::AppendFile m_file;
+  size_t m_maxEntries;
+  size_t m_maxWireSize;
+  size_t m_mask;
+  std::unique_ptr<Slot[]> m_slots;
+  DynamicRegion m_scratch;
+  size_t m_size = 0;
+  size_t m_deadBytes = 0;
+};
+
+/**
+ * @brief Producer that serves Data packets from a DataRepo.
+ *
+ * Only Interests without CanBePrefix are answered.
+ */
+class DataRepoProducer : public PacketHandler {
+public:
+  explicit DataRepoProducer(Face& face, DataRepo& repo, int8_t prio = 0)
+    : PacketHandler(face, prio)
+    , m_repo(repo)
+    , m_region(2 * repo.getMaxWireSize() + lp::EncodableBase::L3MaxSize::value) {}
+
+private:
+  bool processInterest(Interest interest) final {
+    if (interest.getCanBePrefix()) {
+      return false;
+    }
+    m_region.reset();
+    tlv::Value wire = m_repo.getWire(interest.getName(), m_region);
+    if (wire.size() == 0) {
+      return false;
+    }
+    reply(m_region, wire);
+    return true;
+  }
+
+private:
+  DataRepo& m_repo;
+  DynamicRegion m_region;
+};
+
+} // namespace ndnph
+
+#endif // NDNPH_STORE_REPO_HPP
@@ -48,6 +48,15 @@ public:
       d = Tlv{};
       return true;
     }
+    if (end - input >= 2 && input[0] < 0xFD && input[1] < 0xFD) {
+      // fast path: 1-octet TLV-TYPE and TLV-LENGTH, as in most name components and fields
+      d.type = input[0];
+      d.length = input[1];
+      d.value = input + 2;
+      d.tlv = input;
+      d.size = 2 + d.length;
+      return end - d.value >= static_cast<ssize_t>(d.length);
+    }
     int sizeofT = tlv::readVarNum(input, end - input, d.type);
     if (sizeofT == 0) {
       return false;
@@ -14,6 +14,33 @@ public:
     init(buf, capacity);
   }
 
+  /**
+   * @brief Encode an object to the front of given buffer.
+   * @tparam Encodable a class with `size_t encodedSize() const` and
+   *                   `void encodeTo(Encoder&) const` methods.
+   * @return encoded size, or 0 upon error.
+   *
+   * encodedSize() is computed first, and the object is encoded into exactly that much space.
+   * If encodedSize() is exact, the output fills the front of the buffer in place, without copying.
+   * If it is an upper bound, such as when signature length varies, the output is moved to the
+   * front of the buffer.
+   */
+  template<typename Encodable>
+  static size_t encodeInto(uint8_t* buf, size_t capacity, const Encodable& encodable) {
+    size_t size = encodable.encodedSize();
+    if (size == 0 || size > capacity) {
+      return 0;
+    }
+    Encoder encoder(buf, size);
+    if (!encoder.prepend(encodable)) {
+      return 0;
+    }
+    if (encoder.begin() != buf) {
+      std::memmove(buf, encoder.begin(), encoder.size());
+    }
+    return encoder.size();
+  }
+
   /**
    * @brief Create over remaining space in a Region.
    *
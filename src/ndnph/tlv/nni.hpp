@@ -22,6 +22,10 @@ public:
   explicit NNIValue(T number)
     : m_number(number) {}
 
+  size_t encodedSize() const {
+    return sizeof(m_number);
+  }
+
   void encodeTo(Encoder& encoder) const {
     uint8_t* room = encoder.prependRoom(sizeof(m_number));
     if (room != nullptr) {
@@ -149,6 +153,13 @@ public:
   explicit NNI(uint64_t number)
     : m_number(number) {}
 
+  size_t encodedSize() const {
+    return m_number <= std::numeric_limits<uint8_t>::max()    ? 1
+           : m_number <= std::numeric_limits<uint16_t>::max() ? 2
+           : m_number <= std::numeric_limits<uint32_t>::max() ? 4
+                                                              : 8;
+  }
+
   void encodeTo(Encoder& encoder) const {
     if (m_number <= std::numeric_limits<uint8_t>::max()) {
       NNI1(m_number).encodeTo(encoder);
@@ -174,6 +185,10 @@ public:
     : m_type(type)
     , m_nni(value) {}
 
+  size_t encodedSize() const {
+    return sizeofTlv(m_type, m_nni.encodedSize());
+  }
+
   void encodeTo(Encoder& encoder) const {
     encoder.prependTlv(m_type, m_nni);
   }
@@ -47,6 +47,10 @@ public:
     return m_size;
   }
 
+  size_t encodedSize() const {
+    return m_size;
+  }
+
   void encodeTo(Encoder& encoder) const {
     uint8_t* room = encoder.prependRoom(m_size);
     if (room != nullptr) {
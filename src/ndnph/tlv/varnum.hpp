@@ -12,6 +12,12 @@ sizeofVarNum(uint32_t n) {
   return n < 0xFD ? 1 : n <= 0xFFFF ? 3 : 5;
 }
 
+/** @brief Compute size of TLV element with given TLV-TYPE and TLV-LENGTH. */
+constexpr size_t
+sizeofTlv(uint32_t type, size_t length) {
+  return sizeofVarNum(type) + sizeofVarNum(length) + length;
+}
+
 /** @brief Write VAR-NUMBER. */
 inline void
 writeVarNum(uint8_t* room, uint32_t n) {
@@ -1,5 +1,6 @@
 #include "ndnph/app/ping-client.hpp"
 #include "ndnph/app/ping-server.hpp"
+#include "ndnph/keychain/digest.hpp"
 #include "ndnph/keychain/ec.hpp"
 #include "ndnph/keychain/null.hpp"
 
@@ -55,6 +56,177 @@ TEST(Ping, Client) {
   EXPECT_EQ(cnt.nRxData, cnt.nTxInterests - 2);
 }
 
+TEST(Ping, RttHistogram) {
+  ping::RttHistogram hist;
+  EXPECT_EQ(hist.count(), 0);
+  EXPECT_EQ(hist.min(), 0);
+  EXPECT_EQ(hist.quantile(0.5), 0);
+
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    hist.add(i);
+  }
+  hist.add(4000000000);
+  EXPECT_EQ(hist.count(), 1001);
+  EXPECT_EQ(hist.min(), 1);
+  EXPECT_EQ(hist.max(), 4000000000);
+  EXPECT_EQ(hist.mean(), (500500 + 4000000000ULL) / 1001);
+  EXPECT_EQ(hist.quantile(0.0), 1);
+  EXPECT_EQ(hist.quantile(0.004), 5);
+  EXPECT_THAT(hist.quantile(0.5), g::AllOf(g::Ge(501), g::Le(501 * 9 / 8)));
+  EXPECT_THAT(hist.quantile(0.99), g::AllOf(g::Ge(991), g::Le(991 * 9 / 8)));
+  EXPECT_EQ(hist.quantile(1.0), 4000000000);
+
+  hist.clear();
+  EXPECT_EQ(hist.count(), 0);
+  EXPECT_EQ(hist.max(), 0);
+}
+
+TEST(Ping, ConcurrentClient) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  StaticRegion<1024> region;
+  BasicConcurrentPingClient<8>::Options opts;
+  opts.interval = 2;
+  opts.timeout = 40;
+  BasicConcurrentPingClient<8> client(Name::parse(region, "/ping"), face, opts);
+
+  std::vector<std::vector<uint8_t>> interests;
+  EXPECT_CALL(transport, doSend).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    interests.push_back(wire);
+    return true;
+  });
+
+  int nReplies = 0;
+  for (int i = 0; i < 200; ++i) {
+    face.loop();
+    port::Clock::sleep(1);
+
+    if (interests.size() < 3) {
+      continue;
+    }
+    // reply to all but the first Interest in each batch, in reverse order
+    for (size_t j = interests.size() - 1; j > 0; --j) {
+      StaticRegion<1024> region;
+      Interest interest = region.create<Interest>();
+      ASSERT_TRUE(Decoder(interests[j].data(), interests[j].size()).decode(interest));
+      EXPECT_EQ(interest.getLifetime(), 40);
+      Data data = region.create<Data>();
+      data.setName(interest.getName());
+      transport.receive(data.sign(NullKey::get()));
+      ++nReplies;
+    }
+    interests.clear();
+  }
+  for (int i = 0; i < 60; ++i) {
+    face.loop();
+    port::Clock::sleep(1);
+  }
+
+  auto cnt = client.readCounters();
+  EXPECT_GT(cnt.nTxInterests, 30);
+  EXPECT_EQ(cnt.nRxData, nReplies);
+  EXPECT_EQ(cnt.nRxData + cnt.nTimeouts + client.countOutstanding(), cnt.nTxInterests);
+  EXPECT_GT(cnt.nTimeouts, 5);
+
+  const auto& rtt = client.getRtt();
+  EXPECT_EQ(rtt.count(), cnt.nRxData);
+  EXPECT_GE(rtt.min(), 1000);
+  EXPECT_LE(rtt.min(), rtt.quantile(0.5));
+  EXPECT_LE(rtt.quantile(0.5), rtt.quantile(0.99));
+  EXPECT_LE(rtt.quantile(0.99), rtt.max());
+}
+
+TEST(Ping, CongestionWindow) {
+  CongestionWindow::Options opts;
+  opts.initialCwnd = 2;
+  opts.maxCwnd = 20;
+  CongestionWindow cwnd(opts);
+  EXPECT_EQ(cwnd.get(), 2);
+  EXPECT_TRUE(cwnd.canSend(1));
+  EXPECT_FALSE(cwnd.canSend(2));
+
+  for (int i = 0; i < 6; ++i) {
+    cwnd.increase(); // slow start
+  }
+  EXPECT_EQ(cwnd.get(), 8);
+
+  EXPECT_TRUE(cwnd.decrease(100, 110));
+  EXPECT_EQ(cwnd.get(), 4);
+  EXPECT_FALSE(cwnd.decrease(105, 112)); // sent before last decrease
+  EXPECT_EQ(cwnd.get(), 4);
+
+  for (int i = 0; i < 4; ++i) {
+    cwnd.increase(); // congestion avoidance
+  }
+  EXPECT_EQ(cwnd.get(), 4);
+  cwnd.increase();
+  EXPECT_EQ(cwnd.get(), 5);
+
+  EXPECT_TRUE(cwnd.decrease(110, 120));
+  EXPECT_TRUE(cwnd.decrease(120, 130));
+  EXPECT_TRUE(cwnd.decrease(130, 140));
+  EXPECT_EQ(cwnd.get(), 1);
+
+  for (int i = 0; i < 1000; ++i) {
+    cwnd.increase();
+  }
+  EXPECT_EQ(cwnd.get(), 20);
+}
+
+TEST(Ping, ConcurrentClientCongestion) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  StaticRegion<1024> region;
+  BasicConcurrentPingClient<16>::Options opts;
+  opts.interval = 0;
+  opts.timeout = 1000;
+  opts.congestionControl = true;
+  opts.cwnd.initialCwnd = 4;
+  BasicConcurrentPingClient<16> client(Name::parse(region, "/ping"), face, opts);
+
+  std::vector<std::vector<uint8_t>> interests;
+  EXPECT_CALL(transport, doSend).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    interests.push_back(wire);
+    return true;
+  });
+
+  auto replyAll = [&](uint8_t congestionMark) {
+    for (const auto& wire : interests) {
+      StaticRegion<1024> region;
+      Interest interest = region.create<Interest>();
+      ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(interest));
+      Data data = region.create<Data>();
+      data.setName(interest.getName());
+      auto lpp = lp::encode(data.sign(NullKey::get()), lp::PitToken(), congestionMark);
+      transport.receive(lpp);
+    }
+    interests.clear();
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    face.loop();
+  }
+  EXPECT_EQ(interests.size(), 4); // limited by window
+  EXPECT_EQ(client.getCwnd(), 4);
+  replyAll(0);
+  EXPECT_EQ(client.getCwnd(), 8);
+
+  for (int i = 0; i < 10; ++i) {
+    face.loop();
+  }
+  EXPECT_EQ(interests.size(), 8);
+  replyAll(1);
+  EXPECT_EQ(client.getCwnd(), 4); // reduced once per window
+
+  auto cnt = client.readCounters();
+  EXPECT_EQ(cnt.nTxInterests, 12);
+  EXPECT_EQ(cnt.nRxData, 12);
+  EXPECT_EQ(cnt.nCongestionMarks, 8);
+  EXPECT_EQ(cnt.nTimeouts, 0);
+}
+
 TEST(Ping, Server) {
   g::NiceMock<MockTransport> transport;
   Face face(transport);
@@ -93,6 +265,73 @@ TEST(Ping, Server) {
   EXPECT_THAT(dataNames, g::ElementsAreArray(interestNames));
 }
 
+TEST(Ping, FastServer) {
+  g::NiceMock<MockTransport> transportR;
+  Face faceR(transportR);
+  g::NiceMock<MockTransport> transportF;
+  Face faceF(transportF);
+  g::NiceMock<MockTransport> transportC;
+  Face faceC(transportC);
+
+  StaticRegion<1024> sRegion;
+  PingServer serverR(Name::parse(sRegion, "/ping"), faceR);
+  FastPingServer serverF(Name::parse(sRegion, "/ping"), faceF);
+  std::vector<uint8_t> payload(1200, 0xC0);
+  BasicFastPingServer<4096> serverC(Name::parse(sRegion, "/ping"), faceC,
+                                    tlv::Value(payload.data(), payload.size()), 500);
+
+  std::vector<uint8_t> wireR, wireF, wireC;
+  EXPECT_CALL(transportR, doSend)
+    .Times(20)
+    .WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+      wireR = wire;
+      return true;
+    });
+  EXPECT_CALL(transportF, doSend)
+    .Times(20)
+    .WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+      wireF = wire;
+      return true;
+    });
+  EXPECT_CALL(transportC, doSend)
+    .Times(20)
+    .WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+      wireC = wire;
+      return true;
+    });
+
+  for (int i = 0; i < 20; ++i) {
+    std::string uri = "/8=ping/8=" + std::string(i * 20, 'A');
+    StaticRegion<1024> cRegion;
+    Interest interest = cRegion.create<Interest>();
+    interest.setName(Name::parse(cRegion, uri.data()));
+    interest.setMustBeFresh(true);
+    auto lpp = lp::encode(interest, lp::PitToken::from4(0xA0A1A2A3 + i));
+    transportR.receive(lpp);
+    transportF.receive(lpp);
+    transportC.receive(lpp);
+    faceR.loop();
+    faceF.loop();
+    faceC.loop();
+
+    EXPECT_EQ(wireF, wireR);
+
+    StaticRegion<4096> tRegion;
+    lp::PacketClassify classify;
+    ASSERT_TRUE(Decoder(wireC.data(), wireC.size()).decode(classify));
+    EXPECT_EQ(classify.getPitToken(), lp::PitToken::from4(0xA0A1A2A3 + i));
+    Data data = tRegion.create<Data>();
+    ASSERT_TRUE(classify.decodeData(data));
+    EXPECT_EQ(data.getName(), interest.getName());
+    EXPECT_EQ(data.getFreshnessPeriod(), 500);
+    EXPECT_EQ(data.getContent(), tlv::Value(payload.data(), payload.size()));
+    EXPECT_TRUE(data.verify(DigestKey::get()));
+  }
+
+  EXPECT_EQ(serverF.readCounters().nTxData, 20);
+  EXPECT_EQ(serverC.readCounters().nTxData, 20);
+}
+
 using PingEndToEndFixture = BridgeFixture;
 
 TEST_F(PingEndToEndFixture, EndToEnd) {
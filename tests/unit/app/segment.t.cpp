@@ -3,6 +3,7 @@
 
 #include "mock/bridge-fixture.hpp"
 #include "mock/mock-transport.hpp"
+#include "mock/tempdir-fixture.hpp"
 #include "test-common.hpp"
 
 namespace ndnph {
@@ -208,6 +209,156 @@ TEST(Segment, Producer) {
   testOneInterest("/A/AA/AAA/50=%03", false, nullptr, -1);
 }
 
+TEST(Segment, ParallelProducer) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  std::vector<uint8_t> content = makeRandomContent(5000);
+  using Producer = BasicParallelSegmentProducer<convention::Segment, 2048, 2, 4>;
+  Producer::Options opts;
+  opts.contentLen = 100; // 50 segments
+  Producer producer(face, opts);
+
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/P");
+  producer.setContent(prefix, content.data(), content.size());
+  EXPECT_FALSE(producer.isComplete());
+
+  std::atomic_bool stop(false);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < 2; ++i) {
+    workers.emplace_back([&, i] {
+      while (!stop) {
+        if (!producer.work(i)) {
+          port::Clock::sleep(1);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 5000 && !producer.isComplete(); ++i) {
+    face.loop();
+    port::Clock::sleep(1);
+  }
+  stop = true;
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  ASSERT_TRUE(producer.isComplete());
+  EXPECT_EQ(producer.countOutstanding(), 0);
+
+  std::vector<uint8_t> received;
+  EXPECT_CALL(transport, doSend).Times(50).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    NDNPH_ASSERT(!!data);
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(data));
+    EXPECT_TRUE(data.verify(DigestKey::get()));
+    auto c = data.getContent();
+    received.insert(received.end(), c.begin(), c.end());
+    EXPECT_EQ(data.getIsFinalBlock(), received.size() == content.size());
+    return true;
+  });
+  for (uint64_t segment = 0; segment < 50; ++segment) {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    NDNPH_ASSERT(!!interest);
+    interest.setName(prefix.append(region, convention::Segment(), segment));
+    transport.receive(interest);
+  }
+  g::Mock::VerifyAndClearExpectations(&transport);
+  EXPECT_EQ(received, content);
+
+  // segments of new content are signed on Face thread until workers catch up
+  producer.setContent(prefix, content.data(), 150);
+  EXPECT_FALSE(producer.isComplete());
+  EXPECT_CALL(transport, doSend).WillOnce([&](std::vector<uint8_t> wire, uint64_t) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    NDNPH_ASSERT(!!data);
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(data));
+    EXPECT_EQ(data.getContent().size(), 50);
+    EXPECT_TRUE(data.getIsFinalBlock());
+    return true;
+  });
+  {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    NDNPH_ASSERT(!!interest);
+    interest.setName(prefix.append(region, convention::Segment(), 1));
+    transport.receive(interest);
+  }
+}
+
+using SegmentFileFixture = TempDirFixture;
+
+TEST_F(SegmentFileFixture, FileProducer) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+
+  std::vector<uint8_t> content = makeRandomContent(700);
+  std::string filename = tempDir + "/content.bin";
+  {
+    FILE* fp = fopen(filename.data(), "wb");
+    ASSERT_NE(fp, nullptr);
+    ASSERT_EQ(fwrite(content.data(), 1, content.size(), fp), content.size());
+    fclose(fp);
+  }
+
+  FileSegmentProducer::Options opts;
+  opts.contentLen = 300; // ContentL=[300,300,100]
+  FileSegmentProducer producer(face, opts);
+  producer.setReadahead(2);
+
+  StaticRegion<1024> prefixRegion;
+  Name prefix = Name::parse(prefixRegion, "/F");
+  EXPECT_FALSE(producer.setFile(prefix, (tempDir + "/non-existent").data()));
+  ASSERT_TRUE(producer.setFile(prefix, filename.data()));
+
+  std::vector<uint8_t> received;
+  EXPECT_CALL(transport, doSend).Times(3).WillRepeatedly([&](std::vector<uint8_t> wire, uint64_t) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    NDNPH_ASSERT(!!data);
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(data));
+    auto c = data.getContent();
+    received.insert(received.end(), c.begin(), c.end());
+    EXPECT_EQ(data.getIsFinalBlock(), received.size() == content.size());
+    return true;
+  });
+  for (uint64_t segment = 0; segment <= 3; ++segment) {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    NDNPH_ASSERT(!!interest);
+    interest.setName(prefix.append(region, convention::Segment(), segment));
+    transport.receive(interest);
+  }
+  g::Mock::VerifyAndClearExpectations(&transport);
+  EXPECT_EQ(received, content);
+
+  std::string emptyFilename = tempDir + "/empty.bin";
+  fclose(fopen(emptyFilename.data(), "wb"));
+  int fd = ::open(emptyFilename.data(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_TRUE(producer.setFile(prefix, fd));
+  ::close(fd);
+  EXPECT_CALL(transport, doSend).WillOnce([&](std::vector<uint8_t> wire, uint64_t) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    NDNPH_ASSERT(!!data);
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(data));
+    EXPECT_EQ(data.getContent().size(), 0);
+    EXPECT_TRUE(data.getIsFinalBlock());
+    return true;
+  });
+  {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    NDNPH_ASSERT(!!interest);
+    interest.setName(prefix.append(region, convention::Segment(), 0));
+    transport.receive(interest);
+  }
+}
+
 class SegmentEndToEndFixture : public BridgeFixture {
 protected:
   void SetUp() override {
@@ -295,5 +446,51 @@ TEST_F(SegmentEndToEndFixture, SaveToTooShort) {
   EXPECT_TRUE(destB.hasError);
 }
 
+TEST_F(SegmentEndToEndFixture, Manifest) {
+  SegmentProducer::Options optsA;
+  optsA.contentLen = 256;
+  optsA.manifest = true;
+  producerA.reset(new SegmentProducer(faceA, optsA));
+  producerA->setContent(prefix, contentA.data(), contentA.size());
+
+  SegmentConsumer::Options optsB;
+  optsB.retxLimit = 2;
+  optsB.manifest = true;
+  consumerB.reset(new SegmentConsumer(faceB, optsB));
+
+  std::vector<uint8_t> contentB(contentA.size());
+  SegmentConsumer::SaveDest destB(contentB.data(), contentB.size());
+  runInThreads(
+    [&] {
+      consumerB->saveTo(destB);
+      consumerB->start(prefix);
+    },
+    [&] { return consumerB->isRunning(); });
+
+  EXPECT_TRUE(destB.isCompleted);
+  EXPECT_FALSE(destB.hasError);
+  EXPECT_EQ(contentB, contentA);
+}
+
+TEST_F(SegmentEndToEndFixture, ManifestMismatch) {
+  SegmentConsumer::Options optsB;
+  optsB.retxLimit = 1;
+  optsB.retxDelay = 10;
+  optsB.manifest = true;
+  consumerB.reset(new SegmentConsumer(faceB, optsB));
+
+  std::vector<uint8_t> contentB(contentA.size());
+  SegmentConsumer::SaveDest destB(contentB.data(), contentB.size());
+  runInThreads(
+    [&] {
+      consumerB->saveTo(destB);
+      consumerB->start(prefix);
+    },
+    [&] { return consumerB->isRunning(); }, [] {});
+
+  EXPECT_TRUE(destB.hasError);
+  EXPECT_EQ(destB.length, 0);
+}
+
 } // namespace
 } // namespace ndnph
@@ -1,4 +1,5 @@
 #include "ndnph/face/face.hpp"
+#include "ndnph/face/transport-rxqueue.hpp"
 #include "ndnph/keychain/null.hpp"
 
 #include "mock/bridge-fixture.hpp"
@@ -126,6 +127,157 @@ TEST(Face, Send) {
   EXPECT_TRUE(transport.receive(lp::encode(h.request, lp::PitToken::from4(0xDE249BD0)), 3202));
 }
 
+class QueueTransport : public transport::DynamicRxQueueMixin {
+public:
+  void enqueue(const std::vector<uint8_t>& wire) {
+    if (auto r = receiving()) {
+      std::copy(wire.begin(), wire.end(), r.buf());
+      r(wire.size());
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> sent;
+
+private:
+  bool doIsUp() const final {
+    return true;
+  }
+
+  void doLoop() final {
+    loopRxQueue();
+  }
+
+  bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t) final {
+    sent.emplace_back(pkt, pkt + pktLen);
+    return true;
+  }
+};
+
+class GatherTransport : public MockTransport {
+public:
+  bool doCanSendv() const override {
+    return true;
+  }
+
+  bool doSendv(const IoVec* iov, size_t iovcnt, uint64_t endpointId) override {
+    bases.clear();
+    for (size_t i = 0; i < iovcnt; ++i) {
+      bases.push_back(iov[i].base);
+    }
+    return sendvByCopy(iov, iovcnt, endpointId);
+  }
+
+  std::vector<const uint8_t*> bases;
+};
+
+TEST(Face, SendGathered) {
+  g::NiceMock<GatherTransport> transport;
+  Face face(transport);
+  StaticRegion<2048> region;
+
+  std::vector<uint8_t> content(500, 0xC0);
+  tlv::Value chunks[] = {tlv::Value(&content[0], 100), tlv::Value(&content[100], 400)};
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/A"));
+  data.setContent(tlv::Value(content.data(), content.size()));
+  Encoder encoder(region);
+  encoder.prepend(lp::encode(data.sign(NullKey::get()), lp::PitToken::from4(0xA0A1A2A3)));
+  encoder.trim();
+  data.setContent(tlv::Value());
+
+  EXPECT_CALL(transport, doSend(g::ElementsAreArray(encoder.begin(), encoder.end()), 7))
+    .WillOnce(g::Return(true));
+  Face::PacketInfo pi;
+  pi.endpointId = 7;
+  pi.pitToken = lp::PitToken::from4(0xA0A1A2A3);
+  EXPECT_TRUE(face.send(region, data.signGathered(NullKey::get(), chunks, 2), pi));
+  EXPECT_THAT(transport.bases, g::ElementsAre(g::_, content.data(), &content[100], g::_));
+
+  // transport without native sendv receives a linear packet encoded in region
+  g::NiceMock<MockTransport> transportL;
+  Face faceL(transportL);
+  EXPECT_CALL(transportL, doSend(g::ElementsAreArray(encoder.begin(), encoder.end()), 7))
+    .WillOnce(g::Return(true));
+  EXPECT_TRUE(faceL.send(region, data.signGathered(NullKey::get(), chunks, 2), pi));
+}
+
+TEST(Face, SendFragmentsLinear) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+  DynamicRegion fragRegion(4096);
+  lp::Fragmenter fragmenter(fragRegion, 500);
+  face.setFragmenter(fragmenter);
+  StaticRegion<4096> region;
+
+  std::vector<uint8_t> content(1200, 0xC0);
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/A"));
+  data.setContent(tlv::Value(content.data(), content.size()));
+
+  // transport without native sendv receives each fragment encoded in region
+  std::vector<size_t> sentSizes;
+  EXPECT_CALL(transport, doSend).Times(3).WillRepeatedly([&](std::vector<uint8_t> pkt, uint64_t) {
+    sentSizes.push_back(pkt.size());
+    return true;
+  });
+  EXPECT_TRUE(face.send(region, data.sign(NullKey::get()), Face::PacketInfo()));
+  EXPECT_THAT(sentSizes, g::Each(g::Le(500)));
+}
+
+TEST(Face, CongestionMark) {
+  QueueTransport transport;
+  transport.setRxCongestionThreshold(2);
+  Face face(transport);
+  MockPacketHandler h(face);
+  StaticRegion<1024> region;
+
+  std::vector<int> marks;
+  EXPECT_CALL(h, processInterest).Times(5).WillRepeatedly([&](Interest interest) {
+    marks.push_back(h.getCurrentPacketInfo()->congestionMark);
+    if (h.getCurrentPacketInfo()->pitToken.to4() == 0xC0) {
+      Data data = region.create<Data>();
+      data.setName(interest.getName());
+      h.reply(data.sign(NullKey::get()));
+    }
+    return true;
+  });
+
+  Interest interest = region.create<Interest>();
+  interest.setName(Name::parse(region, "/A"));
+  Encoder encoder(region);
+  encoder.prepend(lp::encode(interest, lp::PitToken::from4(0xC0), 1));
+  encoder.trim();
+  transport.enqueue(std::vector<uint8_t>(encoder.begin(), encoder.end()));
+  encoder.discard();
+  for (int i = 0; i < 4; ++i) {
+    Encoder encoder(region);
+    encoder.prepend(lp::encode(interest));
+    encoder.trim();
+    transport.enqueue(std::vector<uint8_t>(encoder.begin(), encoder.end()));
+    encoder.discard();
+  }
+  face.loop();
+  EXPECT_THAT(marks, g::ElementsAre(1, 0, 1, 1, 1));
+
+  // reply does not copy CongestionMark
+  ASSERT_EQ(transport.sent.size(), 1);
+  lp::PacketClassify classify;
+  ASSERT_TRUE(Decoder(transport.sent[0].data(), transport.sent[0].size()).decode(classify));
+  EXPECT_EQ(classify.getType(), lp::PacketClassify::Type::Data);
+  EXPECT_EQ(classify.getPitToken(), lp::PitToken::from4(0xC0));
+  EXPECT_EQ(classify.getCongestionMark(), 0);
+
+  // PacketInfo CongestionMark is encoded
+  transport.sent.clear();
+  Face::PacketInfo pi;
+  pi.congestionMark = 1;
+  ASSERT_TRUE(h.send(interest, pi));
+  ASSERT_EQ(transport.sent.size(), 1);
+  ASSERT_TRUE(Decoder(transport.sent[0].data(), transport.sent[0].size()).decode(classify));
+  EXPECT_EQ(classify.getType(), lp::PacketClassify::Type::Interest);
+  EXPECT_EQ(classify.getCongestionMark(), 1);
+}
+
 TEST(Face, DetachedPacketHandler) {
   MockPacketHandler ph;
   EXPECT_THAT(ph.getCurrentPacketInfo(), g::IsNull());
@@ -0,0 +1,169 @@
+#include "ndnph/face/face.hpp"
+#include "ndnph/keychain/null.hpp"
+
+#include "mock/mock-packet-handler.hpp"
+#include "test-common.hpp"
+
+#include <functional>
+
+namespace ndnph {
+namespace {
+
+/** @brief Transport that delivers packets to its peer during peer's loop, with optional loss. */
+class LossyTransport : public Transport {
+public:
+  /** @brief Predicate to determine whether a packet should be dropped. */
+  std::function<bool(const std::vector<uint8_t>&)> drop;
+  LossyTransport* peer = nullptr;
+
+private:
+  bool doIsUp() const final {
+    return true;
+  }
+
+  void doLoop() final {
+    auto queue = std::move(m_queue);
+    m_queue.clear();
+    for (const auto& pkt : queue) {
+      invokeRxCallback(pkt.data(), pkt.size());
+    }
+  }
+
+  bool doSend(const uint8_t* pkt, size_t pktLen, uint64_t) final {
+    std::vector<uint8_t> wire(pkt, pkt + pktLen);
+    if (!drop || !drop(wire)) {
+      peer->m_queue.push_back(std::move(wire));
+    }
+    return true;
+  }
+
+private:
+  std::vector<std::vector<uint8_t>> m_queue;
+};
+
+class LpReliabilityFixture : public g::Test {
+protected:
+  LpReliabilityFixture()
+    : relA(makeOptions())
+    , relB(makeOptions()) {
+    transportA.peer = &transportB;
+    transportB.peer = &transportA;
+    faceA.setReliability(relA);
+    faceB.setReliability(relB);
+  }
+
+  static lp::Reliability::Options makeOptions() {
+    lp::Reliability::Options opts;
+    opts.mtu = 300;
+    opts.initialRto = 30;
+    opts.minRto = 30;
+    opts.maxRetx = 2;
+    opts.ackDelay = 5;
+    return opts;
+  }
+
+  void sendData(size_t contentL) {
+    StaticRegion<2048> region;
+    Data data = region.create<Data>();
+    data.setName(Name::parse(region, "/D"));
+    std::vector<uint8_t> content(contentL, 0xC0);
+    data.setContent(tlv::Value(content.data(), content.size()));
+    ASSERT_TRUE(faceA.send(region, data.sign(NullKey::get()), Face::PacketInfo()));
+  }
+
+  void runLoops(int duration) {
+    for (int i = 0; i < duration; ++i) {
+      faceA.loop();
+      faceB.loop();
+      port::Clock::sleep(1);
+    }
+  }
+
+protected:
+  LossyTransport transportA;
+  LossyTransport transportB;
+  Face faceA{transportA};
+  Face faceB{transportB};
+  lp::Reliability relA;
+  lp::Reliability relB;
+};
+
+TEST_F(LpReliabilityFixture, Ack) {
+  g::NiceMock<MockPacketHandler> hB(faceB);
+  EXPECT_CALL(hB, processData).Times(2).WillRepeatedly(g::Return(true));
+
+  sendData(10);
+  sendData(10);
+  EXPECT_EQ(relA.countUnacked(), 2);
+  runLoops(20);
+  EXPECT_EQ(relA.countUnacked(), 0);
+
+  auto cntA = relA.readCounters();
+  EXPECT_EQ(cntA.nTx, 2);
+  EXPECT_EQ(cntA.nAcked, 2);
+  EXPECT_EQ(cntA.nRetx, 0);
+  auto cntB = relB.readCounters();
+  EXPECT_EQ(cntB.nIdle, 1); // both Acks in one IDLE packet
+}
+
+TEST_F(LpReliabilityFixture, Retransmit) {
+  g::NiceMock<MockPacketHandler> hB(faceB);
+  EXPECT_CALL(hB, processData).Times(1).WillRepeatedly(g::Return(true));
+
+  int nDrops = 1;
+  transportA.drop = [&](const std::vector<uint8_t>&) { return nDrops-- > 0; };
+  sendData(10);
+  runLoops(100);
+  EXPECT_EQ(relA.countUnacked(), 0);
+  EXPECT_EQ(relA.readCounters().nRetx, 1);
+  EXPECT_EQ(relA.readCounters().nAcked, 1);
+
+  // lost Ack causes a duplicate delivery, which is not filtered by this layer
+  EXPECT_CALL(hB, processData).Times(2).WillRepeatedly(g::Return(true));
+  transportA.drop = nullptr;
+  nDrops = 1;
+  transportB.drop = [&](const std::vector<uint8_t>&) { return nDrops-- > 0; };
+  sendData(10);
+  runLoops(100);
+  EXPECT_EQ(relA.countUnacked(), 0);
+}
+
+TEST_F(LpReliabilityFixture, GiveUp) {
+  transportA.drop = [](const std::vector<uint8_t>&) { return true; };
+  sendData(10);
+  runLoops(300);
+  EXPECT_EQ(relA.countUnacked(), 0);
+  auto cnt = relA.readCounters();
+  EXPECT_EQ(cnt.nTx, 3);
+  EXPECT_EQ(cnt.nRetx, 2);
+  EXPECT_EQ(cnt.nGiveUps, 1);
+  EXPECT_GT(relA.getRto(), 30);
+}
+
+TEST_F(LpReliabilityFixture, Fragments) {
+  DynamicRegion fragRegion(4096);
+  lp::Fragmenter fragmenter(fragRegion, 300 - lp::Reliability::Overhead::value);
+  faceA.setFragmenter(fragmenter);
+  lp::MultiReassembler reass(2, 8, 300, 1000);
+  faceB.setReassembler(reass);
+
+  g::NiceMock<MockPacketHandler> hB(faceB);
+  EXPECT_CALL(hB, processData).WillOnce([](Data data) {
+    EXPECT_EQ(data.getContent().size(), 1000);
+    return true;
+  });
+
+  int nPkts = 0;
+  transportA.drop = [&](const std::vector<uint8_t>& wire) {
+    EXPECT_LE(wire.size(), 300);
+    return ++nPkts == 2;
+  };
+  sendData(1000);
+  EXPECT_GE(relA.countUnacked(), 4);
+  runLoops(100);
+  EXPECT_EQ(relA.countUnacked(), 0);
+  EXPECT_EQ(relA.readCounters().nRetx, 1);
+}
+
+} // namespace
+} // namespace ndnph
@@ -9,6 +9,8 @@ static FILE* tracerFile = nullptr;
 #include "mock/mock-transport.hpp"
 #include "transport-common.hpp"
 
+#include <numeric>
+
 namespace ndnph {
 namespace {
 
@@ -53,6 +55,52 @@ TEST(Transport, Bridge) {
   fclose(tracerFile);
 }
 
+TEST(Transport, Sendv) {
+  struct Received {
+    std::vector<uint8_t> pkt;
+    uint64_t endpointId = 0;
+  } received;
+  auto rxCb = [](void* ctx, const uint8_t* pkt, size_t pktLen, uint64_t endpointId) {
+    auto& received = *static_cast<Received*>(ctx);
+    received.pkt.assign(pkt, pkt + pktLen);
+    received.endpointId = endpointId;
+  };
+
+  BridgeTransport transportA;
+  BridgeTransport transportB;
+  ASSERT_TRUE(transportA.begin(transportB));
+  transportB.setRxCallback(rxCb, &received);
+  transport::ForceEndpointId transportAw(transportA, 4411);
+
+  uint8_t bufX[] = {0xA0, 0xA1};
+  uint8_t bufY[] = {0xB0};
+  Transport::IoVec iov[] = {{bufX, sizeof(bufX)}, {bufY, 0}, {bufY, sizeof(bufY)}};
+  EXPECT_TRUE(transportAw.canSendv());
+  EXPECT_TRUE(transportAw.sendv(iov, 3));
+  transportB.loop();
+  EXPECT_THAT(received.pkt, g::ElementsAre(0xA0, 0xA1, 0xB0));
+  EXPECT_EQ(received.endpointId, 4411);
+
+  tracerFile = tmpfile();
+  transport::Tracer tracerA(transportA, "A");
+  EXPECT_TRUE(tracerA.canSendv());
+  EXPECT_TRUE(tracerA.sendv(iov, 3, 4412));
+  transportB.loop();
+  EXPECT_THAT(received.pkt, g::ElementsAre(0xA0, 0xA1, 0xB0));
+  EXPECT_EQ(received.endpointId, 4412);
+  rewind(tracerFile);
+  char traceLine[1024];
+  ASSERT_NE(fgets(traceLine, sizeof(traceLine), tracerFile), nullptr);
+  EXPECT_NE(strstr(traceLine, " [A] < len=3"), nullptr);
+  fclose(tracerFile);
+
+  g::NiceMock<MockTransport> transportM;
+  EXPECT_FALSE(transportM.canSendv());
+  EXPECT_CALL(transportM, doSend(g::ElementsAre(0xB0, 0xA0, 0xA1), 7)).WillOnce(g::Return(true));
+  Transport::IoVec iovM[] = {{bufY, sizeof(bufY)}, {bufX, sizeof(bufX)}};
+  EXPECT_TRUE(transportM.sendv(iovM, 2, 7));
+}
+
 TEST(Transport, ForceEndpointId) {
   MockTransport transportA;
   MockTransport transportB;
@@ -182,6 +230,32 @@ TEST(Transport, UdpUnicast) {
   Face faceR(transportR);
   TransportTest(face4, faceR).run().check();
   TransportTest(face6, faceR).run().check();
+
+  struct Received {
+    std::vector<uint8_t> pkt;
+    int nPkts = 0;
+  } received;
+  transportR.setRxCallback(
+    [](void* ctx, const uint8_t* pkt, size_t pktLen, uint64_t) {
+      auto& received = *static_cast<Received*>(ctx);
+      received.pkt.assign(pkt, pkt + pktLen);
+      ++received.nPkts;
+    },
+    &received);
+  std::vector<uint8_t> bytes(12);
+  std::iota(bytes.begin(), bytes.end(), 0xC0);
+  std::vector<Transport::IoVec> iov;
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    iov.push_back({&bytes[i], 1});
+  }
+  EXPECT_TRUE(transport4.sendv(iov.data(), 3)); // sendmsg
+  EXPECT_TRUE(transport4.sendv(iov.data(), iov.size())); // gathered copy
+  for (int i = 0; i < 1000 && received.nPkts < 2; ++i) {
+    transportR.loop();
+    port::Clock::sleep(1);
+  }
+  EXPECT_EQ(received.nPkts, 2);
+  EXPECT_EQ(received.pkt, bytes);
 }
 
 } // namespace
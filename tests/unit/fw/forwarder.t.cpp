@@ -0,0 +1,281 @@
+#include "ndnph/fw/forwarder.hpp"
+#include "ndnph/keychain/digest.hpp"
+
+#include "mock/mock-transport.hpp"
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+class ForwarderFixture : public g::Test {
+protected:
+  struct Node {
+    Node() {
+      EXPECT_CALL(transport, doSend)
+        .WillRepeatedly([this](std::vector<uint8_t> wire, uint64_t endpointId) {
+          sent.push_back(wire);
+          sentEndpoints.push_back(endpointId);
+          return true;
+        });
+    }
+
+    /** @brief Decode the only transmitted packet and clear the record. */
+    lp::PacketClassify popSent() {
+      EXPECT_EQ(sent.size(), 1);
+      lp::PacketClassify classify;
+      if (!sent.empty()) {
+        last = sent.back();
+        lastEndpointId = sentEndpoints.back();
+        EXPECT_TRUE(Decoder(last.data(), last.size()).decode(classify));
+      }
+      sent.clear();
+      sentEndpoints.clear();
+      return classify;
+    }
+
+    g::NiceMock<MockTransport> transport;
+    Face face{transport};
+    std::vector<std::vector<uint8_t>> sent;
+    std::vector<uint64_t> sentEndpoints;
+    std::vector<uint8_t> last;
+    uint64_t lastEndpointId = 0;
+  };
+
+  void SetUp() override {
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(fw.addFace(nodes[i].face), i);
+    }
+  }
+
+  Interest makeInterest(const char* uri, uint32_t nonce) {
+    Interest interest = region.create<Interest>();
+    NDNPH_ASSERT(!!interest);
+    interest.setName(Name::parse(region, uri));
+    interest.setNonce(nonce);
+    return interest;
+  }
+
+protected:
+  fw::BasicForwarder<3, 16, 8> fw;
+  Node nodes[3];
+  StaticRegion<4096> region;
+};
+
+TEST_F(ForwarderFixture, InterestData) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 1));
+
+  Interest interestA = makeInterest("/P/1", 0xA0A0A0A0);
+  interestA.setHopLimit(10);
+  nodes[0].transport.receive(lp::encode(interestA, lp::PitToken::from4(0xAAAA)), 3001);
+  auto classifyB = nodes[1].popSent();
+  ASSERT_EQ(classifyB.getType(), lp::PacketClassify::Type::Interest);
+  EXPECT_EQ(classifyB.getPitToken().length(), 4);
+  auto upToken = classifyB.getPitToken();
+  Interest interestB = region.create<Interest>();
+  ASSERT_TRUE(classifyB.decodeInterest(interestB));
+  EXPECT_EQ(interestB.getName(), interestA.getName());
+  EXPECT_EQ(interestB.getNonce(), 0xA0A0A0A0);
+  EXPECT_EQ(interestB.getHopLimit(), 9);
+  EXPECT_EQ(fw.countPitEntries(), 1);
+
+  // same Interest from another face is aggregated
+  nodes[2].transport.receive(
+    lp::encode(makeInterest("/P/1", 0xC0C0C0C0), lp::PitToken::from4(0xCCCC)));
+  EXPECT_EQ(nodes[1].sent.size(), 0);
+  EXPECT_EQ(fw.countPitEntries(), 1);
+
+  // same Nonce from another face is a loop
+  nodes[2].transport.receive(makeInterest("/P/1", 0xA0A0A0A0));
+  auto classifyC = nodes[2].popSent();
+  ASSERT_EQ(classifyC.getType(), lp::PacketClassify::Type::Nack);
+  Nack nackC = region.create<Nack>();
+  ASSERT_TRUE(classifyC.decodeNack(nackC));
+  EXPECT_EQ(nackC.getReason(), NackReason::Duplicate);
+
+  // Data returns to both downstreams with their PIT tokens and endpoint IDs
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/P/1"));
+  nodes[1].transport.receive(lp::encode(data.sign(DigestKey::get()), upToken));
+  auto classifyA = nodes[0].popSent();
+  ASSERT_EQ(classifyA.getType(), lp::PacketClassify::Type::Data);
+  EXPECT_EQ(classifyA.getPitToken(), lp::PitToken::from4(0xAAAA));
+  EXPECT_EQ(nodes[0].lastEndpointId, 3001);
+  classifyC = nodes[2].popSent();
+  ASSERT_EQ(classifyC.getType(), lp::PacketClassify::Type::Data);
+  EXPECT_EQ(classifyC.getPitToken(), lp::PitToken::from4(0xCCCC));
+  EXPECT_EQ(fw.countPitEntries(), 0);
+
+  // unsolicited Data is dropped
+  nodes[1].transport.receive(lp::encode(data.sign(DigestKey::get()), upToken));
+  EXPECT_EQ(nodes[0].sent.size(), 0);
+
+  auto cnt = fw.readCounters();
+  EXPECT_EQ(cnt.nInInterests, 3);
+  EXPECT_EQ(cnt.nOutInterests, 1);
+  EXPECT_EQ(cnt.nAggregated, 1);
+  EXPECT_EQ(cnt.nDuplicateNonce, 1);
+  EXPECT_EQ(cnt.nInData, 2);
+  EXPECT_EQ(cnt.nOutData, 2);
+  EXPECT_EQ(cnt.nUnsolicited, 1);
+}
+
+TEST_F(ForwarderFixture, RemoveFace) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 1));
+
+  nodes[0].transport.receive(lp::encode(makeInterest("/P/1", 0x01), lp::PitToken::from4(0xAA)));
+  auto upToken = nodes[1].popSent().getPitToken();
+  nodes[2].transport.receive(lp::encode(makeInterest("/P/1", 0x02), lp::PitToken::from4(0xCC)));
+  nodes[0].transport.receive(makeInterest("/P/2", 0x03));
+  nodes[1].sent.clear();
+  EXPECT_EQ(fw.countPitEntries(), 2);
+
+  // /P/2 has no other downstream and is erased; /P/1 still has face 2
+  ASSERT_TRUE(fw.removeFace(0));
+  EXPECT_EQ(fw.countPitEntries(), 1);
+
+  // new face reuses slot 0 but receives nothing for the old face's Interests
+  Node added;
+  EXPECT_EQ(fw.addFace(added.face), 0);
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/P/1"));
+  nodes[1].transport.receive(lp::encode(data.sign(DigestKey::get()), upToken));
+  EXPECT_EQ(added.sent.size(), 0);
+  auto classifyC = nodes[2].popSent();
+  ASSERT_EQ(classifyC.getType(), lp::PacketClassify::Type::Data);
+  EXPECT_EQ(classifyC.getPitToken(), lp::PitToken::from4(0xCC));
+  EXPECT_EQ(fw.countPitEntries(), 0);
+  EXPECT_TRUE(fw.removeFace(0));
+}
+
+TEST_F(ForwarderFixture, HopLimit) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 1));
+
+  Interest interestA = makeInterest("/P/1", 0x01);
+  nodes[0].transport.receive(interestA);
+  Interest interestB = region.create<Interest>();
+  ASSERT_TRUE(nodes[1].popSent().decodeInterest(interestB));
+  EXPECT_FALSE(interestB.hasHopLimit());
+
+  interestA = makeInterest("/P/2", 0x02);
+  interestA.setHopLimit(255);
+  nodes[0].transport.receive(interestA);
+  interestB = region.create<Interest>();
+  ASSERT_TRUE(nodes[1].popSent().decodeInterest(interestB));
+  EXPECT_TRUE(interestB.hasHopLimit());
+  EXPECT_EQ(interestB.getHopLimit(), 254);
+
+  interestA = makeInterest("/P/3", 0x03);
+  interestA.setHopLimit(0);
+  nodes[0].transport.receive(interestA);
+  EXPECT_EQ(nodes[1].sent.size(), 0);
+}
+
+TEST_F(ForwarderFixture, DataWithoutPitToken) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/"), 1));
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P/Q"), 2));
+
+  Interest interest = makeInterest("/P/Q/R", 0x01);
+  interest.setCanBePrefix(true);
+  nodes[0].transport.receive(interest);
+  EXPECT_EQ(nodes[1].sent.size(), 0);
+  EXPECT_EQ(nodes[2].popSent().getType(), lp::PacketClassify::Type::Interest);
+
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/P/Q/R/S"));
+  nodes[2].transport.receive(data.sign(DigestKey::get()));
+  auto classifyA = nodes[0].popSent();
+  EXPECT_EQ(classifyA.getType(), lp::PacketClassify::Type::Data);
+  EXPECT_FALSE(classifyA.getPitToken());
+
+  // longest prefix match falls back to shorter route
+  nodes[0].transport.receive(makeInterest("/P/X", 0x02));
+  EXPECT_EQ(nodes[1].popSent().getType(), lp::PacketClassify::Type::Interest);
+  EXPECT_EQ(nodes[2].sent.size(), 0);
+}
+
+TEST_F(ForwarderFixture, AppParameters) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 1));
+
+  Interest interest = makeInterest("/P/params", 0x03);
+  std::vector<uint8_t> appParams({0xC0, 0xC1, 0xC2});
+  Encoder encoder(region);
+  tlv::Value appParamsV(appParams.data(), appParams.size());
+  ASSERT_TRUE(encoder.prepend(interest.parameterize(appParamsV).sign(DigestKey::get())));
+  encoder.trim();
+  Interest decoded = region.create<Interest>();
+  ASSERT_TRUE(Decoder(encoder.begin(), encoder.size()).decode(decoded));
+
+  nodes[0].transport.receive(decoded.forward());
+  auto classifyB = nodes[1].popSent();
+  Interest interestB = region.create<Interest>();
+  ASSERT_TRUE(classifyB.decodeInterest(interestB));
+  EXPECT_EQ(interestB.getName(), decoded.getName());
+  EXPECT_EQ(interestB.getAppParameters(), appParamsV);
+  EXPECT_TRUE(interestB.verify(DigestKey::get()));
+}
+
+TEST_F(ForwarderFixture, Nack) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 1));
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 2));
+
+  // no route
+  nodes[0].transport.receive(makeInterest("/Q", 0x04));
+  auto classifyA = nodes[0].popSent();
+  ASSERT_EQ(classifyA.getType(), lp::PacketClassify::Type::Nack);
+  Nack nackA = region.create<Nack>();
+  ASSERT_TRUE(classifyA.decodeNack(nackA));
+  EXPECT_EQ(nackA.getReason(), NackReason::NoRoute);
+  EXPECT_EQ(fw.countPitEntries(), 0);
+
+  // multicast to two upstreams, Nack is returned after both upstreams Nack
+  nodes[0].transport.receive(
+    lp::encode(makeInterest("/P/2", 0x05), lp::PitToken::from4(0xA5)));
+  std::array<lp::PitToken, 2> upTokens;
+  for (int i = 1; i <= 2; ++i) {
+    auto classify = nodes[i].popSent();
+    ASSERT_EQ(classify.getType(), lp::PacketClassify::Type::Interest);
+    upTokens[i - 1] = classify.getPitToken();
+  }
+
+  Nack nackB = Nack::create(makeInterest("/P/2", 0x05), NackReason::Congestion);
+  nodes[1].transport.receive(lp::encode(nackB, upTokens[0]));
+  EXPECT_EQ(nodes[0].sent.size(), 0);
+  nodes[2].transport.receive(lp::encode(nackB, upTokens[1]));
+  classifyA = nodes[0].popSent();
+  ASSERT_EQ(classifyA.getType(), lp::PacketClassify::Type::Nack);
+  EXPECT_EQ(classifyA.getPitToken(), lp::PitToken::from4(0xA5));
+  nackA = region.create<Nack>();
+  ASSERT_TRUE(classifyA.decodeNack(nackA));
+  EXPECT_EQ(nackA.getReason(), NackReason::Congestion);
+  EXPECT_EQ(nackA.getInterest().getNonce(), 0x05);
+  EXPECT_EQ(fw.countPitEntries(), 0);
+}
+
+TEST_F(ForwarderFixture, Expire) {
+  ASSERT_TRUE(fw.addRoute(Name::parse(region, "/P"), 1));
+
+  for (int i = 0; i < 8; ++i) {
+    Interest interest = makeInterest("/P", 0x10 + i);
+    interest.setName(interest.getName().append(region, convention::Segment(), i));
+    interest.setLifetime(10);
+    nodes[0].transport.receive(interest);
+  }
+  EXPECT_EQ(fw.countPitEntries(), 8);
+  nodes[1].sent.clear();
+
+  // PIT is full
+  nodes[0].transport.receive(makeInterest("/P/full", 0x20));
+  nodes[0].sent.clear();
+  EXPECT_EQ(fw.readCounters().nPitFull, 1);
+
+  port::Clock::sleep(20);
+  fw.loop();
+  EXPECT_EQ(fw.countPitEntries(), 0);
+  EXPECT_EQ(fw.readCounters().nPitExpired, 8);
+
+  nodes[0].transport.receive(makeInterest("/P/full", 0x21));
+  EXPECT_EQ(nodes[1].popSent().getType(), lp::PacketClassify::Type::Interest);
+}
+
+} // namespace
+} // namespace ndnph
@@ -3,6 +3,8 @@
 
 #include "test-common.hpp"
 
+#include <numeric>
+
 namespace ndnph {
 namespace {
 
@@ -110,6 +112,21 @@ TEST(Component, Parse) {
     region.reset();
   }
 
+  {
+    auto comp = Component::parse(region, "%41%4");
+    ASSERT_FALSE(!comp);
+    EXPECT_EQ(comp.length(), 3);
+    EXPECT_EQ(region.size(), 5); // exact allocation
+    region.reset();
+  }
+
+  for (const char* uri : {"A=B", "=B", "0=B", "65536=B"}) {
+    SCOPED_TRACE(uri);
+    auto comp = Component::parse(region, uri);
+    EXPECT_TRUE(!comp);
+    EXPECT_EQ(region.size(), 0);
+  }
+
   {
     region.alloc(1020);
     auto comp = Component::parse(region, "ZZZ");
@@ -118,6 +135,32 @@ TEST(Component, Parse) {
   }
 }
 
+TEST(Component, PrintRoundtrip) {
+  StaticRegion<1024> region;
+  std::vector<uint8_t> value(256);
+  std::iota(value.begin(), value.end(), 0);
+  Component comp(region, 0xFFFF, value.size(), value.data());
+  ASSERT_FALSE(!comp);
+
+  std::string expected = "65535=";
+  for (int ch : value) {
+    if (ch != 0 && std::strchr("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~",
+                               ch) != nullptr) {
+      expected.push_back(ch);
+    } else {
+      char hex[4];
+      std::snprintf(hex, sizeof(hex), "%%%02X", ch);
+      expected.append(hex);
+    }
+  }
+  std::string uri = test::toString(comp);
+  EXPECT_EQ(uri, expected);
+
+  auto parsed = Component::parse(region, uri.data(), uri.size());
+  ASSERT_FALSE(!parsed);
+  EXPECT_EQ(parsed, comp);
+}
+
 TEST(Component, Equality) {
   Component compA, compB;
   EXPECT_EQ(compA, compB);
@@ -1,4 +1,5 @@
 #include "ndnph/packet/data.hpp"
+#include "ndnph/keychain/digest.hpp"
 #include "ndnph/keychain/null.hpp"
 #include "ndnph/packet/lp.hpp"
 
@@ -80,6 +81,7 @@ TEST(Data, EncodeFull) {
   ASSERT_FALSE(!decoded);
   ASSERT_TRUE(classify.decodeData(decoded));
   EXPECT_EQ(decoded.getName(), data.getName());
+  EXPECT_FALSE(decoded.getName().hasIndex()); // index is opt-in via withIndex()
   EXPECT_EQ(decoded.getContentType(), 0x01);
   EXPECT_EQ(decoded.getFreshnessPeriod(), 500);
   EXPECT_EQ(decoded.getIsFinalBlock(), true);
@@ -101,6 +103,164 @@ TEST(Data, EncodeFull) {
   }
 }
 
+TEST(Data, EncodeInto) {
+  StaticRegion<1024> region;
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/A/B"));
+  data.setFreshnessPeriod(500);
+  data.setIsFinalBlock(true);
+  std::vector<uint8_t> content(300, 0xC0);
+  data.setContent(tlv::Value(content.data(), content.size()));
+
+  std::vector<uint8_t> expected;
+  {
+    ScopedEncoder encoder(region);
+    ASSERT_TRUE(encoder.prepend(lp::encode(data.sign(NullKey::get()), lp::PitToken::from4(1))));
+    expected.assign(encoder.begin(), encoder.end());
+  }
+
+  // exact size: output is written in place
+  std::vector<uint8_t> buf(1024, 0xEE);
+  auto signedData = lp::encode(data.sign(NullKey::get()), lp::PitToken::from4(1));
+  EXPECT_EQ(signedData.encodedSize(), expected.size());
+  EXPECT_EQ(Encoder::encodeInto(buf.data(), expected.size() - 1, signedData), 0);
+  ASSERT_EQ(Encoder::encodeInto(buf.data(), buf.size(), signedData), expected.size());
+  EXPECT_THAT(std::vector<uint8_t>(buf.begin(), buf.begin() + expected.size()),
+              g::ElementsAreArray(expected));
+  EXPECT_EQ(buf[expected.size()], 0xEE);
+
+  lp::PacketClassify classify;
+  ASSERT_TRUE(Decoder(buf.data(), expected.size()).decode(classify));
+  Data decoded = region.create<Data>();
+  ASSERT_TRUE(classify.decodeData(decoded));
+  std::vector<uint8_t> copy(decoded.encodedSize());
+  EXPECT_EQ(Encoder::encodeInto(copy.data(), copy.size(), decoded), copy.size());
+  EXPECT_EQ(copy.back(), expected.back());
+
+  // upper bound: signature is shorter than getMaxSigLen()
+  MockPrivateKey<32> key;
+  EXPECT_CALL(key, updateSigInfo).WillOnce([](SigInfo& sigInfo) { sigInfo.sigType = 0x10; });
+  EXPECT_CALL(key, doSign)
+    .WillOnce(g::DoAll(g::SetArrayArgument<1>(&content[0], &content[4]), g::Return(4)));
+  auto mockSigned = data.sign(key);
+  size_t sizeBound = mockSigned.encodedSize();
+  size_t size = Encoder::encodeInto(buf.data(), buf.size(), mockSigned);
+  EXPECT_EQ(size + 28, sizeBound);
+  ASSERT_TRUE(Decoder(buf.data(), size).decode(decoded));
+  EXPECT_EQ(decoded.getName(), data.getName());
+  EXPECT_THAT(decoded.getContent(), g::SizeIs(300));
+}
+
+TEST(Data, SignGathered) {
+  StaticRegion<2048> region;
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/A/B"));
+  data.setFreshnessPeriod(500);
+  data.setIsFinalBlock(true);
+  std::vector<uint8_t> content(400);
+  for (size_t i = 0; i < content.size(); ++i) {
+    content[i] = i;
+  }
+  tlv::Value chunks[] = {
+    tlv::Value(&content[0], 10),
+    tlv::Value(&content[10], &content[10]),
+    tlv::Value(&content[10], 290),
+    tlv::Value(&content[300], 100),
+  };
+
+  for (size_t nChunks : {0, 1, 3, 4}) {
+    SCOPED_TRACE(nChunks);
+    size_t contentL = 0;
+    for (size_t i = 0; i < nChunks; ++i) {
+      contentL += chunks[i].size();
+    }
+    data.setContent(tlv::Value(content.data(), contentL));
+
+    std::vector<uint8_t> expected;
+    {
+      ScopedEncoder encoder(region);
+      ASSERT_TRUE(encoder.prepend(data.sign(DigestKey::get())));
+      expected.assign(encoder.begin(), encoder.end());
+    }
+
+    data.setContent(tlv::Value());
+    auto gathered = data.signGathered(DigestKey::get(), chunks, nChunks);
+    EXPECT_EQ(gathered.encodedSize(), expected.size());
+    {
+      ScopedEncoder encoder(region);
+      ASSERT_TRUE(encoder.prepend(gathered));
+      EXPECT_THAT(std::vector<uint8_t>(encoder.begin(), encoder.end()),
+                  g::ElementsAreArray(expected));
+    }
+
+    ScopedEncoder encoder(region);
+    tlv::Value bufs[Data::Gathered::MaxChunks::value + 2];
+    size_t nBufs = gathered.encodeGatherTo(encoder, bufs);
+    ASSERT_EQ(nBufs, nChunks + 2);
+    EXPECT_EQ(bufs[0].begin(), encoder.begin());
+    EXPECT_EQ(bufs[nBufs - 1].end(), encoder.end());
+    std::vector<uint8_t> actual;
+    for (size_t i = 0; i < nBufs; ++i) {
+      if (i > 0 && i < nBufs - 1) {
+        EXPECT_EQ(bufs[i].begin(), chunks[i - 1].begin());
+      }
+      actual.insert(actual.end(), bufs[i].begin(), bufs[i].end());
+    }
+    EXPECT_THAT(actual, g::ElementsAreArray(expected));
+  }
+
+  MockPrivateKey<32> key;
+  EXPECT_CALL(key, updateSigInfo).WillOnce([](SigInfo& sigInfo) { sigInfo.sigType = 0x10; });
+  EXPECT_CALL(key, doSign)
+    .WillOnce(g::DoAll(g::SetArrayArgument<1>(&content[0], &content[4]), g::Return(4)));
+  ScopedEncoder encoder(region);
+  tlv::Value bufs[Data::Gathered::MaxChunks::value + 2];
+  size_t nBufs = data.signGathered(key, chunks, 4).encodeGatherTo(encoder, bufs);
+  ASSERT_EQ(nBufs, 6);
+  std::vector<uint8_t> wire;
+  for (size_t i = 0; i < nBufs; ++i) {
+    wire.insert(wire.end(), bufs[i].begin(), bufs[i].end());
+  }
+  StaticRegion<1024> decodeRegion;
+  Data decoded = decodeRegion.create<Data>();
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(decoded));
+  EXPECT_THAT(std::vector<uint8_t>(decoded.getContent().begin(), decoded.getContent().end()),
+              g::ElementsAreArray(content));
+  EXPECT_EQ(decoded.getSigInfo()->sigType, 0x10);
+
+  EXPECT_EQ(data.signGathered(NullKey::get(), chunks, 5).encodeGatherTo(encoder, bufs), 0);
+}
+
+TEST(Data, DecodeLazy) {
+  StaticRegion<1024> region;
+
+  auto wire = test::fromHex("060C name=0703080141 siginfo=16031B01C8 sigvalue=1700");
+  Data data = region.create<Data>();
+  ASSERT_TRUE(data.decodeLazy(*Decoder(wire.data(), wire.size()).begin()));
+  EXPECT_THAT(data.getName(), g::SizeIs(1));
+  ASSERT_THAT(data.getSigInfo(), g::NotNull());
+  EXPECT_EQ(data.getSigInfo()->sigType, 0xC8);
+
+  // malformed KeyLocator is detected upon access
+  wire = test::fromHex("0612 name=0703080141 siginfo=1609 sigtype=1B0110 keylocator=1C0407020000"
+                       "sigvalue=1700");
+  data = region.create<Data>();
+  EXPECT_FALSE(Decoder(wire.data(), wire.size()).decode(data));
+
+  data = region.create<Data>();
+  lp::PacketClassify classify;
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
+  ASSERT_TRUE(classify.decodeData(data, true));
+  EXPECT_THAT(data.getName(), g::SizeIs(1));
+  uint8_t digest[NDNPH_SHA256_LEN];
+  EXPECT_TRUE(data.computeImplicitDigest(digest));
+  EXPECT_THAT(data.getSigInfo(), g::IsNull());
+
+  g::NiceMock<MockPublicKey> key;
+  EXPECT_CALL(key, doVerify).Times(0);
+  EXPECT_FALSE(data.verify(key));
+}
+
 TEST(Data, CanSatisfySimple) {
   StaticRegion<1024> region;
 
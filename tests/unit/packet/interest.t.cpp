@@ -93,6 +93,7 @@ TEST(Interest, EncodeFull) {
   ASSERT_FALSE(!decoded);
   ASSERT_TRUE(classify.decodeInterest(decoded));
   EXPECT_EQ(decoded.getName(), interest.getName());
+  EXPECT_FALSE(decoded.getName().hasIndex()); // index is opt-in via withIndex()
   EXPECT_EQ(decoded.getCanBePrefix(), true);
   EXPECT_EQ(decoded.getMustBeFresh(), true);
   EXPECT_EQ(decoded.getFwHint(), interest.getFwHint());
@@ -201,6 +202,83 @@ TEST(Interest, EncodeSignedReplace) {
   }
 }
 
+template<typename Encodable>
+void
+checkEncodeInto(Region& region, const Encodable& encodable) {
+  std::vector<uint8_t> expected;
+  {
+    ScopedEncoder encoder(region);
+    ASSERT_TRUE(encoder.prepend(encodable));
+    expected.assign(encoder.begin(), encoder.end());
+  }
+  EXPECT_EQ(encodable.encodedSize(), expected.size());
+
+  std::vector<uint8_t> buf(1024, 0xEE);
+  ASSERT_EQ(Encoder::encodeInto(buf.data(), buf.size(), encodable), expected.size());
+  EXPECT_THAT(std::vector<uint8_t>(buf.begin(), buf.begin() + expected.size()),
+              g::ElementsAreArray(expected));
+  EXPECT_EQ(buf[expected.size()], 0xEE);
+}
+
+TEST(Interest, EncodeInto) {
+  StaticRegion<2048> region;
+  Interest interest = region.create<Interest>();
+  interest.setName(Name::parse(region, "/A/B"));
+  interest.setNonce(0xA0A1A2A3);
+  std::vector<uint8_t> appParameters(300, 0xC0);
+  MockPrivateKey<32> key;
+  EXPECT_CALL(key, updateSigInfo).WillRepeatedly([](SigInfo& sigInfo) {
+    sigInfo.sigType = 0x10;
+  });
+  EXPECT_CALL(key, doSign)
+    .WillRepeatedly(g::DoAll(
+      g::SetArrayArgument<1>(appParameters.begin(), appParameters.begin() + 32), g::Return(32)));
+  tlv::Value params(appParameters.data(), appParameters.size());
+
+  for (int i = 0; i < 2; ++i) {
+    SCOPED_TRACE(i);
+    checkEncodeInto(region, interest);
+    checkEncodeInto(region, lp::encode(interest, lp::PitToken::from4(0xB0B1B2B3), 1));
+    checkEncodeInto(region, interest.parameterize(params));
+    checkEncodeInto(region, interest.parameterize(params).sign(key));
+    checkEncodeInto(region, interest.forward());
+
+    interest.setName(Name::parse(region, "/A/B/2=N"));
+    interest.setCanBePrefix(true);
+    interest.setMustBeFresh(true);
+    interest.setFwHint(Name::parse(region, "/F"));
+    interest.setLifetime(8000);
+    interest.setHopLimit(64);
+  }
+}
+
+TEST(Interest, DecodeLazy) {
+  StaticRegion<1024> region;
+
+  auto wire = test::fromHex("0509 name=0703080141 appparameters=2402C0C1");
+  Interest interest = region.create<Interest>();
+  ASSERT_TRUE(interest.decodeLazy(*Decoder(wire.data(), wire.size()).begin()));
+  EXPECT_THAT(interest.getName(), g::SizeIs(1));
+  EXPECT_THAT(interest.getAppParameters(), g::SizeIs(2));
+  ASSERT_THAT(interest.getSigInfo(), g::NotNull());
+  EXPECT_EQ(interest.getSigInfo()->sigType, 0);
+
+  // malformed KeyLocator is detected upon access
+  wire = test::fromHex("0514 name=0703080141 appparameters=2400"
+                       "siginfo=2C09 sigtype=1B0110 keylocator=1C0407020000 sigvalue=2E00");
+  interest = region.create<Interest>();
+  EXPECT_FALSE(Decoder(wire.data(), wire.size()).decode(interest));
+
+  interest = region.create<Interest>();
+  lp::PacketClassify classify;
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
+  ASSERT_TRUE(classify.decodeInterest(interest, true));
+  EXPECT_THAT(interest.getName(), g::SizeIs(1));
+  EXPECT_THAT(interest.getSigInfo(), g::IsNull());
+  EXPECT_THAT(interest.getAppParameters(), g::SizeIs(0));
+  EXPECT_FALSE(interest.checkDigest());
+}
+
 template<typename MakePolicy>
 void
 testSigPolicy(MakePolicy makePolicy, bool canDetectReorder = true,
@@ -0,0 +1,292 @@
+#include "ndnph/face/face.hpp"
+#include "ndnph/keychain/null.hpp"
+
+#include "mock/mock-packet-handler.hpp"
+#include "mock/mock-transport.hpp"
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+TEST(Fragmenter, EncodeHeader) {
+  StaticRegion<4096> region;
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/A"));
+  std::vector<uint8_t> content(500, 0xC0);
+  data.setContent(tlv::Value(content.data(), content.size()));
+
+  for (size_t mtu : {200, 1500}) {
+    SCOPED_TRACE(mtu);
+    for (auto pitToken : {lp::PitToken(), lp::PitToken::from4(0xA1A2A3A4)}) {
+      DynamicRegion fragRegion(4096);
+      lp::Fragmenter fragmenter(fragRegion, mtu);
+      auto frag = fragmenter.fragment(lp::encode(data.sign(NullKey::get()), pitToken));
+      ASSERT_NE(frag, nullptr);
+      for (; frag != nullptr; frag = frag->next) {
+        std::vector<uint8_t> expected;
+        {
+          ScopedEncoder encoder(region);
+          ASSERT_TRUE(encoder.prepend(*frag));
+          expected.assign(encoder.begin(), encoder.end());
+        }
+        EXPECT_LE(expected.size(), mtu);
+
+        ScopedEncoder encoder(region);
+        frag->encodeHeaderTo(encoder);
+        ASSERT_TRUE(!!encoder);
+        std::vector<uint8_t> actual(encoder.begin(), encoder.end());
+        actual.insert(actual.end(), frag->payload.begin(), frag->payload.end());
+        EXPECT_EQ(actual, expected);
+      }
+    }
+  }
+}
+
+TEST(Lp, CongestionMark) {
+  StaticRegion<4096> region;
+  Interest interest = region.create<Interest>();
+  interest.setName(Name::parse(region, "/A"));
+
+  std::vector<uint8_t> wire;
+  {
+    ScopedEncoder encoder(region);
+    ASSERT_TRUE(encoder.prepend(lp::encode(interest, lp::PitToken::from4(0xA1A2A3A4), 1)));
+    wire.assign(encoder.begin(), encoder.end());
+  }
+  lp::PacketClassify classify;
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
+  EXPECT_EQ(classify.getType(), lp::PacketClassify::Type::Interest);
+  EXPECT_EQ(classify.getPitToken(), lp::PitToken::from4(0xA1A2A3A4));
+  EXPECT_EQ(classify.getCongestionMark(), 1);
+
+  {
+    ScopedEncoder encoder(region);
+    ASSERT_TRUE(encoder.prepend(lp::encode(interest)));
+    wire.assign(encoder.begin(), encoder.end());
+  }
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
+  EXPECT_EQ(classify.getCongestionMark(), 0);
+
+  // CongestionMark on a non-first fragment applies to the reassembled packet
+  std::vector<uint8_t> content(500, 0xC0);
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/D"));
+  data.setContent(tlv::Value(content.data(), content.size()));
+  DynamicRegion fragRegion(4096);
+  lp::Fragmenter fragmenter(fragRegion, 200);
+  lp::MultiReassembler reass;
+  auto frag = fragmenter.fragment(lp::encode(data.sign(NullKey::get())));
+  ASSERT_NE(frag, nullptr);
+  for (int i = 0; frag != nullptr; frag = frag->next, ++i) {
+    lp::Fragmenter::Fragment marked = *frag;
+    marked.congestionMark = i == 1 ? 1 : 0;
+    ScopedEncoder encoder(region);
+    ASSERT_TRUE(encoder.prepend(marked));
+    ASSERT_TRUE(Decoder(encoder.begin(), encoder.size()).decode(classify));
+    EXPECT_EQ(classify.getCongestionMark(), marked.congestionMark);
+    classify = reass.add(classify.getFragment());
+  }
+  EXPECT_EQ(classify.getType(), lp::PacketClassify::Type::Data);
+  EXPECT_EQ(classify.getCongestionMark(), 1);
+}
+
+TEST(Lp, BurstDecoder) {
+  StaticRegion<4096> region;
+  std::vector<std::vector<uint8_t>> wires;
+  auto addWire = [&](const std::vector<uint8_t>& wire) { wires.push_back(wire); };
+  auto encodeWire = [&](const std::function<bool(Encoder&)>& f) {
+    ScopedEncoder encoder(region);
+    ASSERT_TRUE(f(encoder));
+    addWire(std::vector<uint8_t>(encoder.begin(), encoder.end()));
+  };
+
+  Interest interest = region.create<Interest>();
+  interest.setName(Name::parse(region, "/I"));
+  Data data = region.create<Data>();
+  data.setName(Name::parse(region, "/D"));
+  Nack nack = Nack::create(interest, NackReason::NoRoute);
+
+  encodeWire([&](Encoder& encoder) { return encoder.prepend(interest); });
+  encodeWire([&](Encoder& encoder) {
+    return encoder.prepend(lp::encode(data.sign(NullKey::get()), lp::PitToken::from4(0xA0)));
+  });
+  addWire(test::fromHex("050907030801410A02A0A1"));
+  encodeWire([&](Encoder& encoder) { return encoder.prepend(lp::encode(nack)); });
+  encodeWire([&](Encoder& encoder) {
+    return encoder.prepend(lp::encode(interest, lp::PitToken::from4(0xA1)));
+  });
+  encodeWire([&](Encoder& encoder) { return encoder.prepend(data.sign(NullKey::get())); });
+
+  std::vector<tlv::Value> values;
+  for (const auto& wire : wires) {
+    values.emplace_back(wire.data(), wire.size());
+  }
+
+  using PT = lp::PacketClassify::Type;
+  DynamicRegion burstRegion(4096);
+  lp::BurstDecoder<8> burst;
+  ASSERT_EQ(burst.decode(burstRegion, values.data(), values.size()), 6);
+  EXPECT_EQ(std::distance(burst.begin(), burst.end()), 6);
+
+  EXPECT_EQ(burst[0].classify.getType(), PT::Interest);
+  ASSERT_FALSE(!burst[0].interest);
+  EXPECT_FALSE(!!burst[0].data);
+  EXPECT_EQ(burst[0].interest.getName(), interest.getName());
+
+  EXPECT_EQ(burst[1].classify.getType(), PT::Data);
+  EXPECT_EQ(burst[1].classify.getPitToken(), lp::PitToken::from4(0xA0));
+  EXPECT_FALSE(!!burst[1].interest);
+  ASSERT_FALSE(!burst[1].data);
+  EXPECT_EQ(burst[1].data.getName(), data.getName());
+
+  EXPECT_EQ(burst[2].classify.getType(), PT::Interest);
+  EXPECT_FALSE(!!burst[2].interest);
+  EXPECT_FALSE(!!burst[2].data);
+
+  EXPECT_EQ(burst[3].classify.getType(), PT::Nack);
+  EXPECT_FALSE(!!burst[3].interest);
+  Nack decodedNack = burstRegion.create<Nack>();
+  ASSERT_TRUE(burst[3].classify.decodeNack(decodedNack));
+  EXPECT_EQ(decodedNack.getHeader().getReason(), NackReason::NoRoute);
+
+  EXPECT_EQ(burst[4].classify.getPitToken(), lp::PitToken::from4(0xA1));
+  ASSERT_FALSE(!burst[4].interest);
+  ASSERT_FALSE(!burst[5].data);
+
+  burstRegion.reset();
+  lp::BurstDecoder<2> small;
+  ASSERT_EQ(small.decode(burstRegion, &values[4], 2, true), 2);
+  EXPECT_FALSE(!small[0].interest);
+  EXPECT_FALSE(!small[1].data);
+  ASSERT_EQ(small.decode(burstRegion, values.data(), values.size()), 2);
+  EXPECT_FALSE(!small[0].interest);
+  EXPECT_FALSE(!!small[0].data);
+  EXPECT_FALSE(!small[1].data);
+}
+
+class MultiReassemblerFixture : public g::Test {
+protected:
+  /** @brief Fragment a Data packet and return encoded fragments. */
+  std::vector<std::vector<uint8_t>> makeFragments(const char* uri, size_t contentL,
+                                                  uint32_t pitToken = 0) {
+    StaticRegion<4096> region;
+    Data data = region.create<Data>();
+    data.setName(Name::parse(region, uri));
+    std::vector<uint8_t> content(contentL, 0xC0);
+    data.setContent(tlv::Value(content.data(), content.size()));
+
+    DynamicRegion fragRegion(4096);
+    lp::Fragmenter fragmenter(fragRegion, 200);
+    auto lpp = lp::encode(data.sign(NullKey::get()),
+                          pitToken == 0 ? lp::PitToken() : lp::PitToken::from4(pitToken));
+    std::vector<std::vector<uint8_t>> wires;
+    for (auto frag = fragmenter.fragment(lpp); frag != nullptr; frag = frag->next) {
+      Encoder encoder(region);
+      EXPECT_TRUE(encoder.prepend(*frag));
+      wires.emplace_back(encoder.begin(), encoder.end());
+      encoder.discard();
+    }
+    return wires;
+  }
+
+  /** @brief Add a fragment and return content length of reassembled Data, or -1. */
+  int add(const std::vector<uint8_t>& wire, uint64_t endpointId = 0) {
+    lp::PacketClassify classify;
+    EXPECT_TRUE(Decoder(wire.data(), wire.size()).decode(classify));
+    EXPECT_EQ(classify.getType(), lp::PacketClassify::Type::Fragment);
+    auto result = reass.add(classify.getFragment(), endpointId);
+    if (result.getType() != lp::PacketClassify::Type::Data) {
+      return -1;
+    }
+    lastPitToken = result.getPitToken();
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    EXPECT_TRUE(result.decodeData(data));
+    return data.getContent().size();
+  }
+
+protected:
+  lp::MultiReassembler reass{2, 8, 200, 100};
+  lp::PitToken lastPitToken;
+};
+
+TEST_F(MultiReassemblerFixture, OutOfOrder) {
+  auto fragsA = makeFragments("/A", 800, 0xAAAA);
+  auto fragsB = makeFragments("/B", 600);
+  ASSERT_GE(fragsA.size(), 5);
+  ASSERT_GE(fragsB.size(), 4);
+
+  // interleaved and reversed
+  for (size_t i = fragsA.size() - 1; i > 0; --i) {
+    EXPECT_EQ(add(fragsA[i]), -1);
+    if (i < fragsB.size()) {
+      EXPECT_EQ(add(fragsB[i]), -1);
+    }
+  }
+  EXPECT_EQ(add(fragsA[1]), -1); // duplicate
+  EXPECT_EQ(add(fragsA[0]), 800);
+  EXPECT_EQ(lastPitToken, lp::PitToken::from4(0xAAAA));
+  EXPECT_EQ(add(fragsB[0]), 600);
+  EXPECT_FALSE(lastPitToken);
+
+  // same SeqNumBase from different endpoints are separate packets
+  EXPECT_EQ(add(fragsB[0], 1), -1);
+  EXPECT_EQ(add(fragsB[1], 2), -1);
+  for (size_t i = 1; i < fragsB.size(); ++i) {
+    EXPECT_EQ(add(fragsB[i], 1), i + 1 == fragsB.size() ? 600 : -1);
+  }
+
+  auto cnt = reass.readCounters();
+  EXPECT_EQ(cnt.nDelivered, 3);
+  EXPECT_EQ(cnt.nDuplicates, 1);
+}
+
+TEST_F(MultiReassemblerFixture, EvictTimeout) {
+  auto fragsA = makeFragments("/A", 800);
+  auto fragsB = makeFragments("/B", 800);
+  auto fragsC = makeFragments("/C", 800);
+
+  EXPECT_EQ(add(fragsA[0]), -1);
+  EXPECT_EQ(add(fragsB[0]), -1);
+  EXPECT_EQ(add(fragsC[0]), -1); // evicts /A
+  EXPECT_EQ(reass.readCounters().nEvictions, 1);
+  for (size_t i = 1; i < fragsA.size(); ++i) {
+    EXPECT_EQ(add(fragsA[i]), -1);
+  }
+
+  port::Clock::sleep(150);
+  for (size_t i = 1; i < fragsC.size(); ++i) {
+    EXPECT_EQ(add(fragsC[i]), -1);
+  }
+  EXPECT_GE(reass.readCounters().nTimeouts, 1);
+  EXPECT_EQ(reass.readCounters().nDelivered, 0);
+}
+
+TEST_F(MultiReassemblerFixture, Face) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+  face.setReassembler(reass);
+  MockPacketHandler ph(face);
+  std::vector<size_t> recvSizes;
+  EXPECT_CALL(ph, processData).Times(2).WillRepeatedly([&](Data data) {
+    recvSizes.push_back(data.getContent().size());
+    return true;
+  });
+
+  auto fragsA = makeFragments("/A", 700);
+  auto fragsB = makeFragments("/B", 900);
+  std::swap(fragsA[0], fragsA[2]);
+  std::reverse(fragsB.begin(), fragsB.end());
+  for (size_t i = 0; i < std::max(fragsA.size(), fragsB.size()); ++i) {
+    if (i < fragsB.size()) {
+      transport.receive(fragsB[i], 2);
+    }
+    if (i < fragsA.size()) {
+      transport.receive(fragsA[i], 1);
+    }
+  }
+  EXPECT_THAT(recvSizes, g::UnorderedElementsAre(700, 900));
+}
+
+} // namespace
+} // namespace ndnph
@@ -2,6 +2,8 @@
 
 #include "test-common.hpp"
 
+#include <set>
+
 namespace ndnph {
 namespace {
 
@@ -98,6 +100,22 @@ TEST(Name, Parse) {
     region.reset();
   }
 
+  {
+    auto name = Name::parse(region, "/A/%42%43/.../");
+    ASSERT_FALSE(!name);
+    EXPECT_EQ(name.size(), 4);
+    EXPECT_THAT(std::vector<uint8_t>(name.value(), name.value() + name.length()),
+                g::ElementsAre(0x08, 0x01, 0x41, 0x08, 0x02, 0x42, 0x43, 0x08, 0x00, 0x08, 0x00));
+    EXPECT_EQ(region.size(), name.length()); // exact allocation
+    region.reset();
+  }
+
+  {
+    auto name = Name::parse(region, "/A/B=C");
+    ASSERT_TRUE(!name);
+    EXPECT_EQ(region.size(), 0);
+  }
+
   {
     region.alloc(1020);
     auto name = Name::parse(region, "/ZZZ");
@@ -152,6 +170,80 @@ TEST(Name, Slice) {
   EXPECT_TRUE(!name.getPrefix(-9)); // last<0
 }
 
+TEST(Name, Index) {
+  StaticRegion<1024> region;
+  std::vector<uint8_t> wire({0x07, 0x0C, 0x81, 0x01, 0x41, 0x82, 0x01, 0x42, 0x83, 0x01, 0x43,
+                             0x84, 0x01, 0x44});
+  Name name;
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(name));
+  EXPECT_FALSE(name.hasIndex());
+
+  Decoder::Tlv d;
+  ASSERT_TRUE(Decoder::readTlv(d, wire.data(), wire.data() + wire.size()));
+  ASSERT_TRUE(name.decodeWithIndex(d, region));
+  EXPECT_TRUE(name.hasIndex());
+  ASSERT_THAT(name, g::SizeIs(4));
+  EXPECT_EQ(name[0].type(), 0x81);
+  EXPECT_EQ(name[-1].type(), 0x84);
+  EXPECT_EQ(name[-1].tlv(), &wire[11]);
+  EXPECT_TRUE(!name[4]);
+  EXPECT_TRUE(!name[-5]);
+
+  Name name2 = name.slice(1, 3);
+  EXPECT_TRUE(name2.hasIndex());
+  ASSERT_THAT(name2, g::SizeIs(2));
+  EXPECT_EQ(name2.value(), &wire[5]);
+  EXPECT_EQ(name2.length(), 6);
+  EXPECT_EQ(name2[0].type(), 0x82);
+  EXPECT_EQ(name2[-1].type(), 0x83);
+  EXPECT_EQ(name2.getPrefix(-1)[0].type(), 0x82);
+  EXPECT_EQ(name2.slice(1)[0].type(), 0x83);
+  EXPECT_EQ(name2, name.slice(1, 3).clone(region));
+  EXPECT_TRUE(!name.slice(3, 2));
+
+  Name name3(&wire[2], 12);
+  EXPECT_FALSE(name3.hasIndex());
+  name3 = name3.withIndex(region);
+  EXPECT_TRUE(name3.hasIndex());
+  EXPECT_EQ(name3, name);
+  EXPECT_EQ(name3.getPrefix(-1)[2].type(), 0x83);
+
+  StaticRegion<4> tinyRegion;
+  ASSERT_TRUE(name.decodeWithIndex(d, tinyRegion));
+  EXPECT_FALSE(name.hasIndex());
+  EXPECT_EQ(name[-1].type(), 0x84);
+}
+
+TEST(Name, PrefixHash) {
+  StaticRegion<1024> region;
+  Name name = Name::parse(region, "/A/B/C");
+  Name indexed = name.withIndex(region);
+  ASSERT_TRUE(indexed.hasIndex());
+
+  std::set<uint32_t> hashes;
+  for (int n = -3; n <= 3; ++n) {
+    SCOPED_TRACE(n);
+    uint32_t h = name.getPrefixHash(n);
+    EXPECT_EQ(h, detail::fnv1a(name.value(), name.getPrefix(n).length()));
+    EXPECT_EQ(indexed.getPrefixHash(n), h);
+    EXPECT_EQ(indexed.getPrefix(n).getPrefixHash(), h);
+    hashes.insert(h);
+  }
+  EXPECT_EQ(hashes.size(), 4);
+  EXPECT_EQ(name.getPrefixHash(-3), detail::Fnv1aBasis::value);
+  EXPECT_EQ(name.getPrefixHash(4), 0);
+  EXPECT_EQ(name.getPrefixHash(-4), 0);
+  EXPECT_EQ(Name().getPrefixHash(), detail::Fnv1aBasis::value);
+
+  // slice not starting at the first component does not share prefix hashes
+  EXPECT_EQ(indexed.slice(1).getPrefixHash(1), Name::parse(region, "/B").getPrefixHash());
+
+  Name other = Name::parse(region, "/A/B/D").withIndex(region);
+  EXPECT_NE(indexed, other);
+  EXPECT_EQ(indexed.getPrefix(2), other.getPrefix(2));
+  EXPECT_EQ(indexed, name);
+}
+
 TEST(Name, Append) {
   StaticRegion<1024> region;
   std::vector<uint8_t> wire(
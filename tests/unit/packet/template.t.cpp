@@ -0,0 +1,133 @@
+#include "ndnph/packet/template.hpp"
+#include "ndnph/keychain/digest.hpp"
+#include "ndnph/keychain/null.hpp"
+#include "ndnph/packet/lp.hpp"
+
+#include "mock/mock-key.hpp"
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+template<typename Encodable>
+std::vector<uint8_t>
+encodeToVector(Region& region, const Encodable& encodable) {
+  ScopedEncoder encoder(region);
+  EXPECT_TRUE(encoder.prepend(encodable));
+  return std::vector<uint8_t>(encoder.begin(), encoder.end());
+}
+
+TEST(InterestTemplate, Encode) {
+  StaticRegion<2048> region;
+  Interest proto = region.create<Interest>();
+  {
+    InterestTemplate tpl(region, proto);
+    ASSERT_TRUE(!!tpl);
+    Interest interest = region.create<Interest>();
+    interest.setName(Name::parse(region, "/A/B"));
+    interest.setNonce(0xA0A1A2A3);
+    auto encodable = tpl.encode(interest.getName(), 0xA0A1A2A3);
+    auto wire = encodeToVector(region, encodable);
+    EXPECT_EQ(wire, encodeToVector(region, interest));
+    EXPECT_EQ(encodable.encodedSize(), wire.size());
+  }
+
+  proto.setName(Name::parse(region, "/P"));
+  proto.setCanBePrefix(true);
+  proto.setMustBeFresh(true);
+  proto.setFwHint(Name::parse(region, "/F"));
+  proto.setLifetime(8000);
+  proto.setHopLimit(64);
+  InterestTemplate tpl(region, proto);
+  ASSERT_TRUE(!!tpl);
+  for (const char* uri : {"/A", "/B/C", "/D/E/F"}) {
+    SCOPED_TRACE(uri);
+    Name name = Name::parse(region, uri);
+    proto.setName(name);
+    proto.setNonce(0xB0B1B2B3);
+    auto encodable = tpl.encode(name, 0xB0B1B2B3);
+    auto wire = encodeToVector(region, encodable);
+    EXPECT_EQ(wire, encodeToVector(region, proto));
+    EXPECT_EQ(encodable.encodedSize(), wire.size());
+    EXPECT_EQ(encodeToVector(region, lp::encode(encodable, lp::PitToken::from4(0xC0C1C2C3))),
+              encodeToVector(region, lp::encode(proto, lp::PitToken::from4(0xC0C1C2C3))));
+
+    Interest decoded = region.create<Interest>();
+    ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(decoded));
+    EXPECT_EQ(decoded.getName(), name);
+    EXPECT_EQ(decoded.getFwHint(), proto.getFwHint());
+    EXPECT_EQ(decoded.getLifetime(), 8000);
+    EXPECT_EQ(decoded.getHopLimit(), 64);
+  }
+
+  EXPECT_NE(tpl.encode(Name()).nonce, tpl.encode(Name()).nonce);
+
+  InterestTemplate invalid;
+  EXPECT_FALSE(!!invalid);
+  ScopedEncoder encoder(region);
+  EXPECT_FALSE(encoder.prepend(invalid.encode(Name())));
+}
+
+TEST(DataTemplate, Encode) {
+  StaticRegion<4096> region;
+  Data proto = region.create<Data>();
+  proto.setContentType(ContentType::Key);
+  proto.setFreshnessPeriod(500);
+  std::vector<uint8_t> content(300, 0xC0);
+
+  for (const PrivateKey* key :
+       std::initializer_list<const PrivateKey*>{&NullKey::get(), &DigestKey::get()}) {
+    DataTemplate tpl(region, proto, *key);
+    ASSERT_TRUE(!!tpl);
+    for (const char* uri : {"/A", "/B/C"}) {
+      for (size_t contentL : {0, 10, 300}) {
+        for (bool isFinalBlock : {false, true}) {
+          SCOPED_TRACE(std::string(uri) + " " + std::to_string(contentL) + " " +
+                       std::to_string(isFinalBlock));
+          tlv::Value contentV(content.data(), contentL);
+          proto.setName(Name::parse(region, uri));
+          proto.setContent(contentV);
+          proto.setIsFinalBlock(isFinalBlock);
+
+          auto encodable = tpl.encode(proto.getName(), contentV, isFinalBlock);
+          auto wire = encodeToVector(region, encodable);
+          EXPECT_EQ(wire, encodeToVector(region, proto.sign(*key)));
+          EXPECT_EQ(encodable.encodedSize(), wire.size());
+        }
+      }
+    }
+  }
+
+  proto.setContentType(ContentType::Blob);
+  proto.setFreshnessPeriod(0);
+  MockPrivateKey<32> key;
+  EXPECT_CALL(key, updateSigInfo).WillRepeatedly([](SigInfo& sigInfo) {
+    sigInfo.sigType = 0x10;
+  });
+  EXPECT_CALL(key, doSign)
+    .WillRepeatedly(
+      g::DoAll(g::SetArrayArgument<1>(content.begin(), content.begin() + 4), g::Return(4)));
+  DataTemplate tpl(region, proto, key);
+  ASSERT_TRUE(!!tpl);
+  proto.setName(Name::parse(region, "/M"));
+  proto.setContent(tlv::Value(content.data(), 20));
+  proto.setIsFinalBlock(false);
+  auto encodable = tpl.encode(proto.getName(), proto.getContent());
+  auto wire = encodeToVector(region, encodable);
+  EXPECT_EQ(wire, encodeToVector(region, proto.sign(key)));
+  EXPECT_EQ(encodable.encodedSize(), wire.size() + 28);
+
+  Data decoded = region.create<Data>();
+  ASSERT_TRUE(Decoder(wire.data(), wire.size()).decode(decoded));
+  EXPECT_EQ(decoded.getName(), proto.getName());
+  EXPECT_THAT(decoded.getContent(), g::SizeIs(20));
+  EXPECT_EQ(decoded.getSigInfo()->sigType, 0x10);
+
+  DataTemplate invalid;
+  EXPECT_FALSE(!!invalid);
+  ScopedEncoder encoder(region);
+  EXPECT_FALSE(encoder.prepend(invalid.encode(Name())));
+}
+
+} // namespace
+} // namespace ndnph
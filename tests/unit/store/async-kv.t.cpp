@@ -0,0 +1,154 @@
+#include "ndnph/keychain/digest.hpp"
+#include "ndnph/store/async-kv.hpp"
+
+#include "mock/mock-transport.hpp"
+#include "mock/tempdir-fixture.hpp"
+#include "test-common.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace ndnph {
+namespace {
+
+class AsyncKvStoreFixture : public TempDirFixture {
+protected:
+  void SetUp() override {
+    TempDirFixture::SetUp();
+    ASSERT_TRUE(store.open(tempDir.data()));
+  }
+
+protected:
+  KvStore store;
+  g::NiceMock<MockTransport> transport;
+  Face face{transport};
+};
+
+TEST_F(AsyncKvStoreFixture, Basic) {
+  AsyncKvStore async(face, store);
+
+  struct Result {
+    int nSet = 0;
+    bool setOk = false;
+    std::vector<uint8_t> value;
+  } result;
+  auto setCb = [](void* ctx, const char*, bool ok) {
+    auto& result = *static_cast<Result*>(ctx);
+    ++result.nSet;
+    result.setOk = ok;
+  };
+  auto getCb = [](void* ctx, const char*, tlv::Value value) {
+    static_cast<Result*>(ctx)->value.assign(value.begin(), value.end());
+  };
+
+  uint8_t buf[] = {0xA0, 0xA1, 0xA2};
+  ASSERT_TRUE(async.set("a", tlv::Value(buf, sizeof(buf)), setCb, &result));
+  EXPECT_TRUE(async.set("UPPER", tlv::Value(buf, sizeof(buf)))); // fails in worker
+  EXPECT_FALSE(async.get("0123456789012345678901234567890123456789012345678901234567890123",
+                         getCb, &result)); // key too long
+  EXPECT_EQ(async.countOutstanding(), 2);
+  face.loop();
+  EXPECT_EQ(result.nSet, 0);
+
+  EXPECT_TRUE(async.work());
+  EXPECT_TRUE(async.work());
+  EXPECT_FALSE(async.work());
+  face.loop();
+  EXPECT_EQ(result.nSet, 1);
+  EXPECT_TRUE(result.setOk);
+  EXPECT_EQ(async.countOutstanding(), 0);
+
+  ASSERT_TRUE(async.get("a", getCb, &result));
+  async.work();
+  face.loop();
+  EXPECT_THAT(result.value, g::ElementsAre(0xA0, 0xA1, 0xA2));
+
+  ASSERT_TRUE(async.del("a"));
+  ASSERT_TRUE(async.get("a", getCb, &result));
+  async.work();
+  async.work();
+  face.loop();
+  EXPECT_THAT(result.value, g::IsEmpty());
+}
+
+/** @brief Producer that replies Data after reading its Content from AsyncKvStore. */
+class DeferredProducer : public PacketHandler {
+public:
+  explicit DeferredProducer(Face& face, AsyncKvStore& async)
+    : PacketHandler(face)
+    , m_async(async) {}
+
+  int nReplied = 0;
+
+private:
+  bool processInterest(Interest interest) final {
+    m_pi = *getCurrentPacketInfo();
+    m_region.reset();
+    m_name = interest.getName().clone(m_region);
+    return m_async.get("payload", contentRead, this);
+  }
+
+  static void contentRead(void* self0, const char*, tlv::Value value) {
+    auto self = static_cast<DeferredProducer*>(self0);
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    data.setName(self->m_name);
+    data.setContent(value);
+    self->send(region, data.sign(DigestKey::get()), self->m_pi);
+    ++self->nReplied;
+  }
+
+private:
+  AsyncKvStore& m_async;
+  PacketInfo m_pi;
+  StaticRegion<256> m_region;
+  Name m_name;
+};
+
+TEST_F(AsyncKvStoreFixture, DeferredReply) {
+  uint8_t payload[] = {0xC0, 0xC1};
+  ASSERT_TRUE(store.set("payload", tlv::Value(payload, sizeof(payload))));
+
+  AsyncKvStore async(face, store);
+  DeferredProducer producer(face, async);
+  std::atomic<bool> stop(false);
+  std::thread worker([&] {
+    while (!stop) {
+      if (!async.work()) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::vector<uint8_t> sent;
+  EXPECT_CALL(transport, doSend).WillOnce([&](std::vector<uint8_t> wire, uint64_t endpointId) {
+    sent = wire;
+    EXPECT_EQ(endpointId, 3456);
+    return true;
+  });
+
+  StaticRegion<1024> region;
+  Interest interest = region.create<Interest>();
+  interest.setName(Name::parse(region, "/D"));
+  transport.receive(lp::encode(interest, lp::PitToken::from4(0xA7A7)), 3456);
+  EXPECT_TRUE(sent.empty());
+
+  for (int i = 0; i < 1000 && producer.nReplied == 0; ++i) {
+    face.loop();
+    port::Clock::sleep(1);
+  }
+  stop = true;
+  worker.join();
+  ASSERT_EQ(producer.nReplied, 1);
+
+  lp::PacketClassify classify;
+  ASSERT_TRUE(Decoder(sent.data(), sent.size()).decode(classify));
+  EXPECT_EQ(classify.getPitToken(), lp::PitToken::from4(0xA7A7));
+  Data data = region.create<Data>();
+  ASSERT_TRUE(classify.decodeData(data));
+  EXPECT_EQ(data.getName(), interest.getName());
+  EXPECT_EQ(data.getContent(), tlv::Value(payload, sizeof(payload)));
+}
+
+} // namespace
+} // namespace ndnph
@@ -0,0 +1,158 @@
+#include "ndnph/keychain/digest.hpp"
+#include "ndnph/store/content-store.hpp"
+
+#include "mock/mock-packet-handler.hpp"
+#include "mock/mock-transport.hpp"
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+class ContentStoreFixture : public g::Test {
+protected:
+  ContentStoreFixture() {
+    EXPECT_CALL(transport, doSend).WillRepeatedly([this](std::vector<uint8_t> wire, uint64_t) {
+      sent.push_back(wire);
+      return true;
+    });
+  }
+
+  static std::vector<uint8_t> makeData(const char* uri, uint32_t freshnessPeriod,
+                                       size_t contentLen = 10) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    data.setName(Name::parse(region, uri));
+    data.setFreshnessPeriod(freshnessPeriod);
+    std::vector<uint8_t> content(contentLen, 0xC0);
+    data.setContent(tlv::Value(content.data(), content.size()));
+
+    Encoder encoder(region);
+    encoder.prepend(data.sign(DigestKey::get()));
+    encoder.trim();
+    return std::vector<uint8_t>(encoder.begin(), encoder.end());
+  }
+
+  template<typename CS>
+  bool insert(CS& cs, const std::vector<uint8_t>& wire) {
+    StaticRegion<1024> region;
+    Data data = region.create<Data>();
+    return Decoder(wire.data(), wire.size()).decode(data) && cs.insert(data);
+  }
+
+  /** @brief Send Interest and return the reply. */
+  std::vector<uint8_t> express(const char* uri, bool canBePrefix = false,
+                               bool mustBeFresh = false) {
+    StaticRegion<1024> region;
+    Interest interest = region.create<Interest>();
+    interest.setName(Name::parse(region, uri));
+    interest.setCanBePrefix(canBePrefix);
+    interest.setMustBeFresh(mustBeFresh);
+    sent.clear();
+    transport.receive(interest);
+    return sent.empty() ? std::vector<uint8_t>() : sent.front();
+  }
+
+protected:
+  g::NiceMock<MockTransport> transport;
+  Face face{transport};
+  std::vector<std::vector<uint8_t>> sent;
+};
+
+TEST_F(ContentStoreFixture, Lookup) {
+  ContentStore cs(face);
+  g::NiceMock<MockPacketHandler> next(face);
+  EXPECT_CALL(next, processInterest).Times(5).WillRepeatedly(g::Return(true));
+
+  auto dataA1 = makeData("/A/1", 0);
+  auto dataA2 = makeData("/A/2", 1000);
+  auto dataAB = makeData("/A/B", 1000);
+  auto dataB = makeData("/B", 1000);
+  ASSERT_TRUE(insert(cs, dataA2));
+  ASSERT_TRUE(insert(cs, dataB));
+  ASSERT_TRUE(insert(cs, dataA1));
+  ASSERT_TRUE(insert(cs, dataAB));
+  EXPECT_EQ(cs.size(), 4);
+
+  std::vector<uint8_t> miss;
+  EXPECT_EQ(express("/A/1"), dataA1);
+  EXPECT_EQ(express("/A/2"), dataA2);
+  EXPECT_EQ(express("/A"), miss);                 // exact match required
+  EXPECT_EQ(express("/A", true), dataA1);         // leftmost child
+  EXPECT_EQ(express("/A", true, true), dataA2);   // skip stale /A/1
+  EXPECT_EQ(express("/A/1", false, true), miss);  // stale
+  EXPECT_EQ(express("/A/B", true), dataAB);
+  EXPECT_EQ(express("/A/B/C", true), miss);
+  EXPECT_EQ(express("/", true), dataA1);
+  EXPECT_EQ(express("/C", true), miss);
+
+  auto cnt = cs.readCounters();
+  EXPECT_EQ(cnt.nHits, 6);
+  EXPECT_EQ(cnt.nMisses, 4);
+  EXPECT_EQ(cnt.nInserts, 4);
+
+  // replace existing packet
+  auto dataA1b = makeData("/A/1", 2000, 20);
+  ASSERT_TRUE(insert(cs, dataA1b));
+  EXPECT_EQ(cs.size(), 4);
+  EXPECT_EQ(express("/A/1", false, true), dataA1b);
+
+  // FreshnessPeriod above INT_MAX milliseconds
+  auto dataA2b = makeData("/A/2", 0xFFFFFFFF);
+  ASSERT_TRUE(insert(cs, dataA2b));
+  EXPECT_EQ(express("/A/2", false, true), dataA2b);
+
+  cs.clear();
+  EXPECT_EQ(cs.size(), 0);
+  EXPECT_EQ(express("/A/1"), miss);
+}
+
+TEST_F(ContentStoreFixture, IncomingData) {
+  ContentStore cs(face);
+  g::NiceMock<MockPacketHandler> next(face);
+  EXPECT_CALL(next, processData).WillOnce(g::Return(true));
+
+  auto data = makeData("/D", 1000);
+  transport.receive(data);
+  EXPECT_EQ(cs.size(), 1);
+  EXPECT_EQ(express("/D"), data);
+}
+
+TEST_F(ContentStoreFixture, Evict) {
+  // 8 slabs of 128 octets; each packet below occupies 3 slabs
+  BasicContentStore<4, 64, 128> cs(face, 1024, 1024);
+
+  auto data0 = makeData("/E/0", 1000, 300);
+  auto data1 = makeData("/E/1", 1000, 300);
+  auto data2 = makeData("/E/2", 1000, 300);
+  auto data3 = makeData("/E/3", 1000, 300);
+  ASSERT_EQ((data0.size() + 127) / 128, 3);
+  ASSERT_TRUE(insert(cs, data0));
+  ASSERT_TRUE(insert(cs, data1));
+  EXPECT_EQ(express("/E/0"), data0); // /E/0 becomes most recently used
+
+  ASSERT_TRUE(insert(cs, data2)); // evicts /E/1
+  EXPECT_EQ(cs.size(), 2);
+  EXPECT_EQ(express("/E/1"), std::vector<uint8_t>());
+  EXPECT_EQ(express("/E/0"), data0);
+  EXPECT_EQ(express("/E/2"), data2);
+
+  ASSERT_TRUE(insert(cs, data3)); // evicts /E/0
+  EXPECT_EQ(express("/E/0"), std::vector<uint8_t>());
+  EXPECT_EQ(express("/E/3"), data3);
+  EXPECT_EQ(cs.readCounters().nEvictions, 2);
+
+  // too large for the arena
+  EXPECT_FALSE(insert(cs, makeData("/E/L", 1000, 1000)));
+
+  // entry table limit
+  for (int i = 0; i < 10; ++i) {
+    std::string uri = "/S/" + std::to_string(i);
+    ASSERT_TRUE(insert(cs, makeData(uri.data(), 1000)));
+  }
+  EXPECT_EQ(cs.size(), 4);
+  EXPECT_EQ(express("/S/9"), makeData("/S/9", 1000));
+  EXPECT_EQ(express("/S/5"), std::vector<uint8_t>());
+}
+
+} // namespace
+} // namespace ndnph
@@ -35,5 +35,86 @@ TEST_F(KvStoreFixture, Simple) {
   EXPECT_EQ(v2.size(), 0);
 }
 
+TEST_F(KvStoreFixture, Mapped) {
+  KvStore store;
+  ASSERT_TRUE(store.open(tempDir.data()));
+  EXPECT_EQ(store.getMapped("non_existent").size(), 0);
+
+  uint8_t buf[300];
+  memset(buf, 0xA1, sizeof(buf));
+  ASSERT_TRUE(store.set("item", tlv::Value(buf, 200)));
+  tlv::Value v1 = store.getMapped("item");
+  EXPECT_THAT(std::vector<uint8_t>(v1.begin(), v1.end()), g::ElementsAreArray(buf, 200));
+  tlv::Value v2 = store.getMapped("item");
+  EXPECT_EQ(v2.begin(), v1.begin()); // mapping is cached
+
+  memset(buf, 0xA2, sizeof(buf));
+  ASSERT_TRUE(store.set("item", tlv::Value(buf, 300))); // invalidates mapping
+  tlv::Value v3 = store.getMapped("item");
+  EXPECT_THAT(std::vector<uint8_t>(v3.begin(), v3.end()), g::ElementsAreArray(buf, 300));
+
+  ASSERT_TRUE(store.del("item"));
+  EXPECT_EQ(store.getMapped("item").size(), 0);
+}
+
+TEST_F(KvStoreFixture, Batch) {
+  KvStore store;
+  ASSERT_TRUE(store.open(tempDir.data()));
+  StaticRegion<1024> region;
+  uint8_t buf[16];
+  memset(buf, 0xB1, sizeof(buf));
+  ASSERT_TRUE(store.set("b", tlv::Value(buf, 16)));
+  memset(buf, 0xB2, sizeof(buf));
+  ASSERT_TRUE(store.set("b", tlv::Value(buf, 4))); // shorter value leaves no stale tail
+  EXPECT_EQ(store.get("b", region), tlv::Value(buf, 4));
+  ASSERT_TRUE(store.set("b2", tlv::Value(buf, 4)));
+
+  store.beginBatch();
+  memset(buf, 0xB3, sizeof(buf));
+  ASSERT_TRUE(store.set("b", tlv::Value(buf, 8)));
+  ASSERT_TRUE(store.set("c", tlv::Value(buf, 8)));
+  ASSERT_TRUE(store.set("d", tlv::Value(buf, 8)));
+  ASSERT_TRUE(store.del("d"));
+  ASSERT_TRUE(store.del("b2"));
+  EXPECT_EQ(store.get("b", region).size(), 4); // not visible before commit
+  EXPECT_EQ(store.get("c", region).size(), 0);
+  EXPECT_EQ(store.get("b2", region).size(), 4); // deletion deferred until commit
+  ASSERT_TRUE(store.commitBatch());
+
+  EXPECT_EQ(store.get("b", region), tlv::Value(buf, 8));
+  EXPECT_EQ(store.get("c", region), tlv::Value(buf, 8));
+  EXPECT_EQ(store.get("d", region).size(), 0);
+  EXPECT_EQ(store.get("b2", region).size(), 0);
+  EXPECT_EQ(::access((tempDir + "/b.tmp").data(), F_OK), -1);
+  EXPECT_EQ(::access((tempDir + "/d.tmp").data(), F_OK), -1);
+}
+
+TEST_F(KvStoreFixture, BatchUncommitted) {
+  uint8_t buf[4];
+  memset(buf, 0xE1, sizeof(buf));
+  {
+    KvStore store;
+    ASSERT_TRUE(store.open(tempDir.data()));
+    ASSERT_TRUE(store.set("e", tlv::Value(buf, 4)));
+    store.beginBatch();
+    ASSERT_TRUE(store.set("f", tlv::Value(buf, 4)));
+    ASSERT_TRUE(store.del("e"));
+    EXPECT_EQ(::access((tempDir + "/f.tmp").data(), F_OK), 0);
+  }
+  EXPECT_EQ(::access((tempDir + "/f.tmp").data(), F_OK), -1);
+
+  // simulate a crash that leaves a temporary file behind
+  FILE* leftover = fopen((tempDir + "/g.tmp").data(), "w");
+  ASSERT_NE(leftover, nullptr);
+  fclose(leftover);
+
+  KvStore store;
+  ASSERT_TRUE(store.open(tempDir.data()));
+  EXPECT_EQ(::access((tempDir + "/g.tmp").data(), F_OK), -1);
+  StaticRegion<1024> region;
+  EXPECT_EQ(store.get("e", region), tlv::Value(buf, 4));
+  EXPECT_EQ(store.get("f", region).size(), 0);
+}
+
 } // namespace
 } // namespace ndnph
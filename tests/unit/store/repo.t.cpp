@@ -0,0 +1,219 @@
+#include "ndnph/keychain/digest.hpp"
+#include "ndnph/store/repo.hpp"
+
+#include "mock/mock-transport.hpp"
+#include "mock/tempdir-fixture.hpp"
+#include "test-common.hpp"
+
+namespace ndnph {
+namespace {
+
+class DataRepoFixture : public TempDirFixture {
+protected:
+  void SetUp() override {
+    TempDirFixture::SetUp();
+    path = tempDir + "/repo.log";
+  }
+
+  bool insert(DataRepo& repo, const char* uri, uint8_t content = 0xC0) {
+    Data data = region.create<Data>();
+    data.setName(Name::parse(region, uri));
+    data.setContent(tlv::Value(&content, 1));
+    return repo.insert(data.sign(DigestKey::get()));
+  }
+
+  /** @brief Retrieve a packet and return its first Content octet, or -1 if not found. */
+  int get(DataRepo& repo, const char* uri) {
+    Data data = repo.get(Name::parse(region, uri), region);
+    if (!data || data.getContent().size() != 1) {
+      return -1;
+    }
+    return data.getContent().begin()[0];
+  }
+
+protected:
+  std::string path;
+  StaticRegion<65536> region;
+};
+
+TEST_F(DataRepoFixture, InsertGet) {
+  {
+    DataRepo repo(4, 1024);
+    ASSERT_TRUE(repo.open(path.data()));
+    EXPECT_EQ(repo.size(), 0);
+    EXPECT_EQ(get(repo, "/A"), -1);
+
+    ASSERT_TRUE(insert(repo, "/A", 0xA0));
+    ASSERT_TRUE(insert(repo, "/B", 0xB0));
+    ASSERT_TRUE(insert(repo, "/A", 0xA1)); // replace
+    ASSERT_TRUE(insert(repo, "/C", 0xC0));
+    ASSERT_TRUE(insert(repo, "/D", 0xD0));
+    EXPECT_FALSE(insert(repo, "/E", 0xE0)); // index full
+    EXPECT_EQ(repo.size(), 4);
+    EXPECT_EQ(get(repo, "/A"), 0xA1);
+    EXPECT_EQ(get(repo, "/B"), 0xB0);
+    EXPECT_EQ(get(repo, "/E"), -1);
+
+    EXPECT_TRUE(repo.erase(Name::parse(region, "/B")));
+    EXPECT_TRUE(repo.erase(Name::parse(region, "/Z")));
+    EXPECT_EQ(repo.size(), 3);
+    EXPECT_EQ(get(repo, "/B"), -1);
+    EXPECT_EQ(get(repo, "/C"), 0xC0);
+    EXPECT_GT(repo.deadBytes(), 0);
+    EXPECT_TRUE(repo.sync());
+  }
+
+  DataRepo repo(4, 1024);
+  ASSERT_TRUE(repo.open(path.data()));
+  EXPECT_EQ(repo.size(), 3);
+  EXPECT_EQ(get(repo, "/A"), 0xA1);
+  EXPECT_EQ(get(repo, "/B"), -1);
+  EXPECT_EQ(get(repo, "/C"), 0xC0);
+  EXPECT_EQ(get(repo, "/D"), 0xD0);
+
+  size_t logSize = repo.logSize();
+  size_t deadBytes = repo.deadBytes();
+  ASSERT_TRUE(repo.compact());
+  EXPECT_EQ(repo.logSize(), logSize - deadBytes);
+  EXPECT_EQ(repo.deadBytes(), 0);
+  EXPECT_EQ(get(repo, "/A"), 0xA1);
+  EXPECT_EQ(get(repo, "/D"), 0xD0);
+  ASSERT_TRUE(insert(repo, "/E", 0xE0));
+  EXPECT_EQ(get(repo, "/E"), 0xE0);
+
+  DataRepo repo2(4, 1024);
+  ASSERT_TRUE(repo2.open(path.data()));
+  EXPECT_EQ(repo2.size(), 4);
+  EXPECT_EQ(repo2.deadBytes(), 0);
+  EXPECT_EQ(get(repo2, "/C"), 0xC0);
+  EXPECT_EQ(get(repo2, "/E"), 0xE0);
+}
+
+TEST_F(DataRepoFixture, Recover) {
+  size_t goodSize = 0;
+  {
+    DataRepo repo;
+    ASSERT_TRUE(repo.open(path.data()));
+    ASSERT_TRUE(insert(repo, "/A", 0xA0));
+    ASSERT_TRUE(insert(repo, "/B", 0xB0));
+    goodSize = repo.logSize();
+    ASSERT_TRUE(insert(repo, "/C", 0xC0));
+  }
+
+  // simulate a torn write of the last record
+  ASSERT_EQ(::truncate(path.data(), goodSize + 20), 0);
+  {
+    DataRepo repo;
+    ASSERT_TRUE(repo.open(path.data()));
+    EXPECT_EQ(repo.logSize(), goodSize);
+    EXPECT_EQ(repo.size(), 2);
+    EXPECT_EQ(get(repo, "/B"), 0xB0);
+    EXPECT_EQ(get(repo, "/C"), -1);
+    ASSERT_TRUE(insert(repo, "/C", 0xC1));
+  }
+
+  // corrupt the payload of the last record
+  FILE* file = fopen(path.data(), "r+b");
+  ASSERT_NE(file, nullptr);
+  fseek(file, -1, SEEK_END);
+  fputc(0xFF, file);
+  fclose(file);
+  {
+    DataRepo repo;
+    ASSERT_TRUE(repo.open(path.data()));
+    EXPECT_EQ(repo.logSize(), goodSize);
+    EXPECT_EQ(repo.size(), 2);
+    EXPECT_EQ(get(repo, "/C"), -1);
+  }
+}
+
+TEST_F(DataRepoFixture, RecoverMiddle) {
+  size_t logSize = 0;
+  {
+    DataRepo repo;
+    ASSERT_TRUE(repo.open(path.data()));
+    ASSERT_TRUE(insert(repo, "/A", 0xA0));
+
+    std::vector<uint8_t> content(2000, 0xB0);
+    Data data = region.create<Data>();
+    data.setName(Name::parse(region, "/B"));
+    data.setContent(tlv::Value(content.data(), content.size()));
+    ASSERT_TRUE(repo.insert(data.sign(DigestKey::get())));
+
+    ASSERT_TRUE(insert(repo, "/C", 0xC0));
+    logSize = repo.logSize();
+  }
+
+  // a record exceeding maxWireSize is not a torn tail
+  {
+    DataRepo repo(1024, 1000);
+    EXPECT_FALSE(repo.open(path.data()));
+  }
+  {
+    DataRepo repo;
+    ASSERT_TRUE(repo.open(path.data()));
+    EXPECT_EQ(repo.logSize(), logSize);
+    EXPECT_EQ(repo.size(), 3);
+    EXPECT_EQ(get(repo, "/A"), 0xA0);
+    EXPECT_EQ(repo.get(Name::parse(region, "/B"), region).getContent().size(), 2000);
+    EXPECT_EQ(get(repo, "/C"), 0xC0);
+  }
+
+  // corrupt the payload of the first record
+  FILE* file = fopen(path.data(), "r+b");
+  ASSERT_NE(file, nullptr);
+  fseek(file, 12, SEEK_SET);
+  fputc(0xFF, file);
+  fclose(file);
+  {
+    DataRepo repo;
+    EXPECT_FALSE(repo.open(path.data()));
+  }
+  struct stat st;
+  ASSERT_EQ(::stat(path.data(), &st), 0);
+  EXPECT_EQ(static_cast<size_t>(st.st_size), logSize);
+}
+
+TEST_F(DataRepoFixture, EraseMany) {
+  DataRepo repo(64, 1024);
+  ASSERT_TRUE(repo.open(path.data()));
+  for (int i = 0; i < 64; ++i) {
+    std::string uri = "/N/" + std::to_string(i);
+    ASSERT_TRUE(insert(repo, uri.data(), i));
+  }
+  for (int i = 0; i < 64; i += 2) {
+    std::string uri = "/N/" + std::to_string(i);
+    ASSERT_TRUE(repo.erase(Name::parse(region, uri.data())));
+  }
+  EXPECT_EQ(repo.size(), 32);
+  for (int i = 0; i < 64; ++i) {
+    std::string uri = "/N/" + std::to_string(i);
+    EXPECT_EQ(get(repo, uri.data()), i % 2 == 0 ? -1 : i);
+  }
+}
+
+TEST_F(DataRepoFixture, Producer) {
+  g::NiceMock<MockTransport> transport;
+  Face face(transport);
+  DataRepo repo(16, 1024);
+  ASSERT_TRUE(repo.open(path.data()));
+  DataRepoProducer producer(face, repo);
+  ASSERT_TRUE(insert(repo, "/P", 0xF0));
+  tlv::Value stored = repo.getWire(Name::parse(region, "/P"), region);
+
+  std::vector<uint8_t> sent;
+  EXPECT_CALL(transport, doSend).WillOnce([&](std::vector<uint8_t> wire, uint64_t) {
+    sent = wire;
+    return true;
+  });
+  Interest interest = region.create<Interest>();
+  interest.setName(Name::parse(region, "/P"));
+  transport.receive(interest);
+  EXPECT_THAT(sent, g::ElementsAreArray(stored.begin(), stored.size()));
+
+  interest.setName(Name::parse(region, "/Q"));
+  transport.receive(interest);
+}
+
+} // namespace
+} // namespace ndnph
@@ -43,6 +43,35 @@ TEST(Decoder, DecodeGood) {
   ASSERT_TRUE(it == end);
 }
 
+TEST(Decoder, DecodeVarNumMix) {
+  std::vector<uint8_t> wire({0x01, 0xFD, 0x01, 0x00});
+  wire.resize(wire.size() + 0x100, 0xA1);
+  wire.insert(wire.end(), {0xFD, 0x01, 0x00, 0x00, 0x02, 0x00});
+  Decoder decoder(wire.data(), wire.size());
+
+  auto it = decoder.begin(), end = decoder.end();
+  ASSERT_TRUE(it != end);
+  EXPECT_EQ(it->type, 0x01);
+  EXPECT_EQ(it->length, 0x100);
+  EXPECT_EQ(it->value, &wire[4]);
+  EXPECT_EQ(it->size, 0x104);
+
+  ++it;
+  ASSERT_TRUE(it != end);
+  EXPECT_EQ(it->type, 0x0100);
+  EXPECT_EQ(it->length, 0);
+  EXPECT_EQ(it->size, 4);
+
+  ++it;
+  ASSERT_TRUE(it != end);
+  EXPECT_EQ(it->type, 0x02);
+  EXPECT_EQ(it->length, 0);
+
+  ++it;
+  ASSERT_TRUE(it == end);
+  EXPECT_FALSE(it.hasError());
+}
+
 TEST(Decoder, DecodeBad) {
   // missing TLV-TYPE
   std::vector<uint8_t> wire1({});
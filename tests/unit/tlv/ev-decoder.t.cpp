@@ -162,5 +162,20 @@ TEST(EvDecoder, All) {
   EXPECT_FALSE(it.hasError());
 }
 
+TEST(EvDecoder, DuplicateType) {
+  auto wire = test::fromHex("A006 A100 A400 A100");
+  Decoder::Tlv d;
+  ASSERT_TRUE(Decoder::readTlv(d, wire.data(), wire.data() + wire.size()));
+
+  // the first def with matching TLV-TYPE is used, so that the second A1 is out of order
+  int nFirst = 0, nSecond = 0;
+  EXPECT_FALSE(EvDecoder::decode(d, {0xA0},
+                                 EvDecoder::def<0xA1>([&](const Decoder::Tlv&) { ++nFirst; }),
+                                 EvDecoder::defIgnore<0xA4>(),
+                                 EvDecoder::def<0xA1>([&](const Decoder::Tlv&) { ++nSecond; })));
+  EXPECT_EQ(nFirst, 1);
+  EXPECT_EQ(nSecond, 0);
+}
+
 } // namespace
 } // namespace ndnph
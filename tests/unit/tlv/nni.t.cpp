@@ -165,6 +165,13 @@ TEST(NNI, Encode) {
   encoder.prepend(tlv::NNI1(0x00), tlv::NNI4(0x00), tlv::NNI8(0x00), tlv::NNI(0x00),
                   tlv::NNI(0x0100), tlv::NNI(0x00010000), tlv::NNI(0x0000000100000000));
   EXPECT_TRUE(!encoder);
+
+  EXPECT_EQ(tlv::NNI(0x00).encodedSize(), 1);
+  EXPECT_EQ(tlv::NNI(0x0100).encodedSize(), 2);
+  EXPECT_EQ(tlv::NNI(0x00010000).encodedSize(), 4);
+  EXPECT_EQ(tlv::NNI(0x0000000100000000).encodedSize(), 8);
+  EXPECT_EQ(tlv::NniElement<tlv::NNI4>(0xC0, 0).encodedSize(), 6);
+  EXPECT_EQ(tlv::NniElement<>(0xFD, 0x0100).encodedSize(), 6);
 }
 
 } // namespace